@@ -3,8 +3,11 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <stdexcept>
+#include <numeric>
+#include <limits>
 
-Algebra::Algebra(int bits) : bits(bits), boundedMode(false) {
+Algebra::Algebra(int bits) : bits(bits), boundedMode(false), cycleLength(1) {
     // Generate elements dynamically based on bits
     // bits = 8 → elements = {a, b, c, d, e, f, g, h} (8 elements)
     //
@@ -53,11 +56,27 @@ void Algebra::setPlusOneRule(const std::string& rule) {
     }
     
     // Build the algebra structure
+    // Drop the tables of the previous rule so nothing reads them while recompiling
+    additionTable.clear();
+    additionCarryTable.clear();
+    multiplicationTable.clear();
+    multiplicationCarryTable.clear();
+    subtractionTable.clear();
+    divisionTable.clear();
+    powerTable.clear();
+    gcdTable.clear();
+    lcmTable.clear();
+    
+    buildSuccessors();
     BuildHasse();
+    buildPositionIndex();
+    radix = RadixConverter(cycleLength);
     buildAdditionTable();
     buildMultiplicationTable();
     buildSubtractionTable();
     buildDivisionTable();
+    buildPowerTable();
+    buildGcdLcmTables();
 }
 // TODO : prepolnenie : DONE , a/a = min - max : DONE
 // TODO : DONE  
@@ -142,19 +161,14 @@ void Algebra::BuildHasse() {
     char current = additiveIdentity;
     int steps = static_cast<int>(elements.size());
     for (int step = 1; step < steps; ++step) {
-        // find index of current in elements
-        auto it = std::find(elements.begin(), elements.end(), current);
-        if (it == elements.end()) break; // unknown element
-        int idx = static_cast<int>(std::distance(elements.begin(), it));
-
-        // ensure plusOneRule has entry for this input
-        if (idx < 0 || idx >= static_cast<int>(plusOneRule.size()) || plusOneRule[idx].empty()) {
-            // cannot continue the chain
+        int idx = elementId(current);
+        if (idx < 0 || successor[idx] < 0) {
+            // unknown element or no +1 entry, cannot continue the chain
             break;
         }
 
-        // Use the first element in the output list as the chain next element
-        char next = plusOneRule[idx][0];
+        // The successor is the first element in the output list
+        char next = elements[successor[idx]];
 
         // If we've already assigned a position to 'next', we've closed the cycle
         if (elementPosition.find(next) != elementPosition.end()) {
@@ -252,124 +266,176 @@ void Algebra::BuildHasse() {
         }
     }
 }//last variant , g , derived elements , cant be result of + , * but can be result of - and / (ask how to handle)
+
+void Algebra::buildSuccessors() {
+    // successor[i] is the id of the first element in plusOneRule[i], the representative used when walking +1
+    successor.assign(elements.size(), -1);
+    for (size_t i = 0; i < plusOneRule.size() && i < elements.size(); i++) {
+        if (!plusOneRule[i].empty()) {
+            successor[i] = elementId(plusOneRule[i][0]);
+        }
+    }
+}
+
+void Algebra::buildPositionIndex() {
+    positionOf.assign(elements.size(), -1);
+    int maxPos = 0;
+    for (const auto& [elem, pos] : elementPosition) {
+        int id = elementId(elem);
+        if (id >= 0) positionOf[id] = pos;
+        if (pos > maxPos) maxPos = pos;
+    }
+    cycleLength = maxPos + 1;  // If max position is 6, we have 7 positions (0-6)
+    
+    // Representative of each position: the element the +1 chain from the additive identity lands on
+    positionElement.assign(cycleLength, additiveIdentity);
+    std::vector<bool> assigned(cycleLength, false);
+    int id = elementId(additiveIdentity);
+    for (int step = 0; step < cycleLength && id >= 0 && positionOf[id] == step; step++) {
+        positionElement[step] = elements[id];
+        assigned[step] = true;
+        id = successor[id];
+    }
+    
+    // Positions reached only through derived elements take their first element
+    for (size_t i = 0; i < elements.size(); i++) {
+        int pos = positionOf[i];
+        if (pos >= 0 && !assigned[pos]) {
+            positionElement[pos] = elements[i];
+            assigned[pos] = true;
+        }
+    }
+    
+    // Display label of each position: its elements in order, in braces when shared
+    std::vector<std::string> members(cycleLength);
+    for (size_t i = 0; i < elements.size(); i++) {
+        int pos = positionOf[i];
+        if (pos >= 0) members[pos] += elements[i];
+    }
+    positionLabel.assign(cycleLength, "?");
+    for (int pos = 0; pos < cycleLength; pos++) {
+        const std::string& elems = members[pos];
+        if (elems.size() == 1) {
+            positionLabel[pos] = elems;
+        } else if (elems.size() > 1) {
+            std::string label = "{";
+            for (size_t i = 0; i < elems.size(); i++) {
+                if (i > 0) label += ',';
+                label += elems[i];
+            }
+            label += '}';
+            positionLabel[pos] = label;
+        }
+    }
+}
+
+int Algebra::positionOfElement(char element) const {
+    int id = elementId(element);
+    if (id < 0 || id >= static_cast<int>(positionOf.size()) || positionOf[id] < 0) {
+        throw std::out_of_range(std::string("Element has no position: ") + element);
+    }
+    return positionOf[id];
+}
 void Algebra::buildAdditionTable() {
-    additionTable.clear();
-    additionCarryTable.clear();
+    size_t n = elements.size();
+    std::vector<uint8_t> results(n * n);
+    std::vector<uint8_t> carries(n * n);
     
     // Build addition table with carry tracking
-    for (char x : elements) {
-        for (char y : elements) {
+    for (size_t x = 0; x < n; x++) {
+        for (size_t y = 0; y < n; y++) {
             int carry = 0;
-            additionTable[{x, y}] = addWithCarry(x, y, carry);
-            additionCarryTable[{x, y}] = carry;
+            char sum = computeAddWithCarry(elements[x], elements[y], carry);
+            results[x * n + y] = static_cast<uint8_t>(elementId(sum));
+            carries[x * n + y] = static_cast<uint8_t>(carry);
         }
     }
+    
+    additionTable = std::move(results);
+    additionCarryTable = std::move(carries);
+}
+
+int Algebra::elementId(char element) const {
+    // Elements are generated contiguously from 'a', so the id is the offset
+    int id = element - 'a';
+    if (id < 0 || id >= static_cast<int>(elements.size())) return -1;
+    return id;
+}
+
+int Algebra::tableCell(const std::vector<uint8_t>& table, char a, char b) const {
+    size_t n = elements.size();
+    if (table.size() != n * n) return -1;  // Not compiled yet
+    
+    int idA = elementId(a);
+    int idB = elementId(b);
+    if (idA < 0 || idB < 0) return -1;
+    return idA * static_cast<int>(n) + idB;
 }
 
 int Algebra::getCycleLength() const {
-    // Find the number of distinct positions in the Hasse diagram
+    // Number of distinct positions in the Hasse diagram, precomputed with the rule
     // This is the cycle length for modular arithmetic
-    int maxPos = 0;
-    for (const auto& [elem, pos] : elementPosition) {
-        if (pos > maxPos) maxPos = pos;
-    }
-    return maxPos + 1;  // If max position is 6, we have 7 positions (0-6)
+    return cycleLength;
 }
 
 std::string Algebra::formatMultiDigitResult(const std::string& result) const {
     // Format a multi-digit result, replacing each character with its position representation
     // If multiple elements share a position, show them in braces: {d,f}
+    // Anything that is not an element ('-', "∅", the range brackets) is copied as is
+    auto labelOf = [this](char c) -> const std::string* {
+        int id = elementId(c);
+        if (id < 0 || id >= static_cast<int>(positionOf.size()) || positionOf[id] < 0) return nullptr;
+        return &positionLabel[positionOf[id]];
+    };
     
-    // Handle division by zero result
-    if (result == "∅") {
-        return "∅";
-    }
-    
-    // Handle negative numbers
-    if (!result.empty() && result[0] == '-') {
-        std::string formatted = "-";
-        for (size_t i = 1; i < result.length(); i++) {
-            // Skip non-element characters
-            if (elementPosition.find(result[i]) == elementPosition.end()) {
-                formatted += result[i];
-                continue;
-            }
-            int pos = elementPosition.at(result[i]);
-            std::string posStr = getElementsAtPosition(pos);
-            formatted += posStr;
-        }
-        return formatted;
+    size_t length = 0;
+    for (char c : result) {
+        const std::string* label = labelOf(c);
+        length += label ? label->length() : 1;
     }
     
     std::string formatted;
+    formatted.reserve(length);
     for (char c : result) {
-        // Skip non-element characters
-        if (elementPosition.find(c) == elementPosition.end()) {
+        const std::string* label = labelOf(c);
+        if (label) {
+            formatted += *label;
+        } else {
             formatted += c;
-            continue;
         }
-        int pos = elementPosition.at(c);
-        std::string posStr = getElementsAtPosition(pos);
-        formatted += posStr;
     }
-    
     return formatted;
 }
 //can also change to addWithCarry(char a, char b, char& c) so it counts the carry in the same algebra
 char Algebra::addWithCarry(char a, char b, int& carry) const {
-    // To compute a + b with carry:
-    // Start with a, then add 'b' (multiplicative identity) repeatedly
-    // for elementPosition[b] times, tracking how many times we cycle
-    
-    char result = a;
-    int steps = elementPosition.at(b);
-    carry = 0;
+    int cell = tableCell(additionTable, a, b);
+    if (cell < 0) return computeAddWithCarry(a, b, carry);
     
-    int cycleLength = getCycleLength();
-    
-    for (int i = 0; i < steps; i++) {
-        // result = result + 'b' (the multiplicative identity element)
-        // Find result in elements array to get its index
-        auto it = std::find(elements.begin(), elements.end(), result);
-        if (it != elements.end()) {
-            int idx = std::distance(elements.begin(), it);
-            // plusOneRule[idx] is a vector, take the first element
-            if (!plusOneRule[idx].empty()) {
-                char next = plusOneRule[idx][0];  // Apply +b using the rule
-                
-                // Check if we're wrapping around (carry occurs)
-                int currentPos = elementPosition.at(result);
-                int nextPos = elementPosition.at(next);
-                
-                // If next position is less than current, we've wrapped around
-                if (nextPos < currentPos) {
-                    carry++;
-                }
-                
-                result = next;
-            }
-        }
-    }
-    
-    return result;
+    carry = additionCarryTable[cell];
+    return elements[additionTable[cell]];
 }
 
-int Algebra::getAdditionCarry(char a, char b) const {
-    auto it = additionCarryTable.find({a, b});
-    if (it != additionCarryTable.end()) {
-        return it->second;
+char Algebra::computeAddWithCarry(char a, char b, int& carry) const {
+    // Adding b walks the +1 chain elementPosition[b] times from a, so in
+    // position terms a + b lands on (pos(a) + pos(b)) mod cycle length and
+    // wraps around the cycle once for every full cycle length passed
+    int posA = positionOfElement(a);
+    int posB = positionOfElement(b);
+    if (posB == 0) {
+        // Zero steps, a is left as is (even if it is not its position's representative)
+        carry = 0;
+        return a;
     }
-    return 0;
+    
+    int sum = posA + posB;
+    carry = sum / cycleLength;
+    return positionElement[sum % cycleLength];
 }
 
-char Algebra::addMultipleTimes(char element, int times) const {
-    if (times == 0) return additiveIdentity;
-    
-    char result = additiveIdentity;
-    for (int i = 0; i < times; i++) {
-        result = add(result, element);
-    }
-    return result;
+int Algebra::getAdditionCarry(char a, char b) const {
+    int cell = tableCell(additionCarryTable, a, b);
+    if (cell < 0) return 0;
+    return additionCarryTable[cell];
 }
 
 char Algebra::addMultipleTimesWithCarry(char element, int times, int& carry) const {
@@ -391,48 +457,65 @@ char Algebra::addMultipleTimesWithCarry(char element, int times, int& carry) con
 }
 
 std::string Algebra::getElementsAtPosition(int position) const {
-    // Find all elements at this position
-    std::vector<char> elemsAtPos;
-    for (const auto& [elem, pos] : elementPosition) {
-        if (pos == position) {
-            elemsAtPos.push_back(elem);
-        }
-    }
-    
-    // Sort for consistent display
-    std::sort(elemsAtPos.begin(), elemsAtPos.end());
-    
-    // Format output
-    if (elemsAtPos.empty()) {
+    // Labels are precomputed in buildPositionIndex
+    if (position < 0 || position >= static_cast<int>(positionLabel.size())) {
         return "?";
-    } else if (elemsAtPos.size() == 1) {
-        return std::string(1, elemsAtPos[0]);
-    } else {
-        std::string result = "{";
-        for (size_t i = 0; i < elemsAtPos.size(); i++) {
-            result += elemsAtPos[i];
-            if (i < elemsAtPos.size() - 1) result += ",";
-        }
-        result += "}";
-        return result;
     }
+    return positionLabel[position];
 }
 
 void Algebra::buildMultiplicationTable() {
-    multiplicationTable.clear();
-    multiplicationCarryTable.clear();
-    
-    // Build multiplication table with carry tracking
-    for (char x : elements) {
-        for (char y : elements) {
+    size_t n = elements.size();
+    std::vector<uint8_t> results(n * n);
+    std::vector<uint8_t> carries(n * n);
+    
+    // Build multiplication table with carry tracking (uses the compiled addition table).
+    // a * b adds a to itself pos(b) times, so one running sum per row
+    // (0, a, a + a, ...) serves the whole row: O(n) per row instead of per cell
+    std::vector<char> multiples(cycleLength);
+    std::vector<int> multipleCarries(cycleLength);
+    for (size_t x = 0; x < n; x++) {
+        char sum = additiveIdentity;
+        int sumCarry = 0;
+        for (int k = 0; k < cycleLength; k++) {
+            multiples[k] = sum;
+            multipleCarries[k] = sumCarry;
+            int stepCarry = 0;
+            sum = addWithCarry(sum, elements[x], stepCarry);
+            sumCarry += stepCarry;
+        }
+        
+        for (size_t y = 0; y < n; y++) {
+            char a = elements[x];
+            char b = elements[y];
             int carry = 0;
-            multiplicationTable[{x, y}] = multiplyWithCarry(x, y, carry);
-            multiplicationCarryTable[{x, y}] = carry;
+            char product;
+            if (a == additiveIdentity || b == additiveIdentity ||
+                a == multiplicativeIdentity || b == multiplicativeIdentity) {
+                product = computeMultiplyWithCarry(a, b, carry);  // Identities, no repeated addition
+            } else {
+                int times = positionOfElement(b);
+                product = multiples[times];
+                carry = multipleCarries[times];
+            }
+            results[x * n + y] = static_cast<uint8_t>(elementId(product));
+            carries[x * n + y] = static_cast<uint8_t>(carry);
         }
     }
+    
+    multiplicationTable = std::move(results);
+    multiplicationCarryTable = std::move(carries);
 }
 
 char Algebra::multiplyWithCarry(char a, char b, int& carry) const {
+    int cell = tableCell(multiplicationTable, a, b);
+    if (cell < 0) return computeMultiplyWithCarry(a, b, carry);
+    
+    carry = multiplicationCarryTable[cell];
+    return elements[multiplicationTable[cell]];
+}
+
+char Algebra::computeMultiplyWithCarry(char a, char b, int& carry) const {
     // Handle special cases with identities
     if (a == additiveIdentity || b == additiveIdentity) {
         // x * a = a for all x (given property)
@@ -453,38 +536,158 @@ char Algebra::multiplyWithCarry(char a, char b, int& carry) const {
     }
     
     // General case: a * b = add a to itself b times, tracking carries
-    int bPos = elementPosition.at(b);
+    int bPos = positionOfElement(b);
     return addMultipleTimesWithCarry(a, bPos, carry);
 }
 
 int Algebra::getMultiplicationCarry(char a, char b) const {
-    auto it = multiplicationCarryTable.find({a, b});
-    if (it != multiplicationCarryTable.end()) {
-        return it->second;
+    int cell = tableCell(multiplicationCarryTable, a, b);
+    if (cell < 0) return 0;
+    return multiplicationCarryTable[cell];
+}
+
+// Inverse of one row of a compiled table: inverse[r] = id of the first x (in element
+// order) with row[x] == r, or fallback if there is none. That is the x the
+// search in computeSubtract/computeDivide finds
+static void invertTableRow(const uint8_t* row, size_t n, uint8_t fallback, std::vector<uint8_t>& inverse) {
+    const uint8_t unset = 0xFF;
+    inverse.assign(n, unset);
+    for (size_t x = 0; x < n; x++) {
+        if (row[x] < n && inverse[row[x]] == unset) {
+            inverse[row[x]] = static_cast<uint8_t>(x);
+        }
+    }
+    for (uint8_t& id : inverse) {
+        if (id == unset) id = fallback;
     }
-    return 0;
 }
 
 void Algebra::buildSubtractionTable() {
-    subtractionTable.clear();
-    
-    // Build subtraction table using the subtract function
-    for (char x : elements) {
-        for (char y : elements) {
-            subtractionTable[{x, y}] = subtract(x, y);
+    size_t n = elements.size();
+    std::vector<uint8_t> results(n * n);
+    
+    // Build subtraction table by solving b + x = a against the compiled addition table:
+    // row b of the addition table, inverted, gives a - b for every a
+    uint8_t zero = static_cast<uint8_t>(elementId(additiveIdentity));
+    std::vector<uint8_t> inverse;
+    for (size_t y = 0; y < n; y++) {
+        invertTableRow(&additionTable[y * n], n, zero, inverse);
+        for (size_t x = 0; x < n; x++) {
+            results[x * n + y] = inverse[x];
         }
     }
+    
+    subtractionTable = std::move(results);
 }
 
 void Algebra::buildDivisionTable() {
-    divisionTable.clear();
+    size_t n = elements.size();
+    std::vector<uint8_t> results(n * n);
+    
+    // Build division table by solving b * x = a against the compiled multiplication table:
+    // row b of the multiplication table, inverted, gives a / b for every a.
+    // Division by the additive identity gives the additive identity, like computeDivide
+    uint8_t zero = static_cast<uint8_t>(elementId(additiveIdentity));
+    std::vector<uint8_t> inverse;
+    for (size_t y = 0; y < n; y++) {
+        if (elements[y] == additiveIdentity) {
+            inverse.assign(n, zero);
+        } else {
+            invertTableRow(&multiplicationTable[y * n], n, zero, inverse);
+        }
+        for (size_t x = 0; x < n; x++) {
+            results[x * n + y] = inverse[x];
+        }
+    }
     
-    // Build division table using the divide function
-    for (char x : elements) {
-        for (char y : elements) {
-            divisionTable[{x, y}] = divide(x, y);
+    divisionTable = std::move(results);
+}
+
+void Algebra::buildPowerTable() {
+    size_t n = elements.size();
+    std::vector<uint8_t> results(n * n);
+    
+    // Exponentiation by squaring against the compiled multiplication table, O(log n) per cell
+    for (size_t x = 0; x < n; x++) {
+        for (size_t y = 0; y < n; y++) {
+            int id = elementId(computePower(elements[x], elements[y]));
+            if (id < 0) return;  // x^0 of a one-element algebra is 'b', not an element: leave the table empty, power() keeps the computed path
+            results[x * n + y] = static_cast<uint8_t>(id);
         }
     }
+    
+    powerTable = std::move(results);
+}
+
+void Algebra::buildGcdLcmTables() {
+    size_t n = elements.size();
+    
+    // divides[d * n + m]: d * x = m for some x, read off row d of the multiplication table
+    std::vector<uint8_t> divides(n * n, 0);
+    for (size_t d = 0; d < n; d++) {
+        for (size_t x = 0; x < n; x++) {
+            divides[d * n + multiplicationTable[d * n + x]] = 1;
+        }
+    }
+    
+    // Candidates in the order computeGcd and computeLcm try them: by position,
+    // highest first for the GCD and lowest first for the LCM, elements of one
+    // position in element order
+    std::vector<std::pair<int, int>> byPosition;  // (position, id)
+    for (const auto& [elem, pos] : elementPosition) {
+        byPosition.push_back({pos, elementId(elem)});
+    }
+    std::sort(byPosition.begin(), byPosition.end());
+    std::vector<int> lcmCandidates;
+    for (const auto& [pos, id] : byPosition) {
+        if (pos < static_cast<int>(n)) lcmCandidates.push_back(id);
+    }
+    std::stable_sort(byPosition.begin(), byPosition.end(),
+                     [](const std::pair<int, int>& l, const std::pair<int, int>& r) { return l.first > r.first; });
+    
+    int zero = elementId(additiveIdentity);
+    int one = elementId(multiplicativeIdentity);
+    std::vector<uint8_t> gcds(n * n);
+    std::vector<uint8_t> lcms(n * n);
+    for (size_t a = 0; a < n; a++) {
+        for (size_t b = 0; b < n; b++) {
+            // GCD: the first common divisor, the multiplicative identity if there is none
+            int gcdId = one;
+            if (static_cast<int>(a) == zero) {
+                gcdId = static_cast<int>(b);
+            } else if (static_cast<int>(b) == zero) {
+                gcdId = static_cast<int>(a);
+            } else {
+                for (const auto& candidate : byPosition) {
+                    int d = candidate.second;
+                    if (divides[d * n + a] && divides[d * n + b]) {
+                        gcdId = d;
+                        break;
+                    }
+                }
+            }
+            
+            // LCM: the first common multiple, the last element if there is none
+            int lcmId = static_cast<int>(n) - 1;
+            if (static_cast<int>(a) == zero || static_cast<int>(b) == zero) {
+                lcmId = zero;
+            } else {
+                for (int m : lcmCandidates) {
+                    if (divides[a * n + m] && divides[b * n + m]) {
+                        lcmId = m;
+                        break;
+                    }
+                }
+            }
+            
+            if (gcdId < 0) return;  // 'b' of a one-element algebra: keep computing
+            gcds[a * n + b] = static_cast<uint8_t>(gcdId);
+            lcms[a * n + b] = static_cast<uint8_t>(lcmId);
+        }
+    }
+    
+    gcdTable = std::move(gcds);
+    lcmTable = std::move(lcms);
 }
 
 void Algebra::printHasseDiagram() const {
@@ -525,52 +728,22 @@ void Algebra::printHasseDiagram() const {
 }
 
 char Algebra::add(char a, char b) const {
-    // To compute a + b:
-    // Start with a, then add 'b' (multiplicative identity) repeatedly
-    // for elementPosition[b] times
-    
-    char result = a;
-    int steps = elementPosition.at(b);
-    
-    for (int i = 0; i < steps; i++) {
-        // result = result + 'b' (the multiplicative identity element)
-        // Find result in elements array to get its index
-        auto it = std::find(elements.begin(), elements.end(), result);
-        if (it != elements.end()) {
-            int idx = std::distance(elements.begin(), it);
-            // plusOneRule[idx] is a vector, take the first element
-            if (!plusOneRule[idx].empty()) {
-                result = plusOneRule[idx][0];  // Apply +b using the rule
-            }
-        }
-    }
-    
-    return result;
+    int carry = 0;
+    return addWithCarry(a, b, carry);
 }
 
 char Algebra::multiply(char a, char b) const {
-    // Handle special cases with identities
-    if (a == additiveIdentity || b == additiveIdentity) {
-        // x * a = a for all x (given property)
-        return additiveIdentity;
-    }
-    
-    if (b == multiplicativeIdentity) {
-        // x * b = x (b is multiplicative identity)
-        return a;
-    }
-    
-    if (a == multiplicativeIdentity) {
-        // b * y = y (b is multiplicative identity, commutative)
-        return b;
-    }
-    
-    // General case: a * b = add a to itself b times
-    int bPos = elementPosition.at(b);
-    return addMultipleTimes(a, bPos);
+    int carry = 0;
+    return multiplyWithCarry(a, b, carry);
 }
 
 char Algebra::power(char base, char exponent) const {
+    int cell = tableCell(powerTable, base, exponent);
+    if (cell < 0) return computePower(base, exponent);
+    return elements[powerTable[cell]];
+}
+
+char Algebra::computePower(char base, char exponent) const {
     // Calculate base^exponent
     // exponent's position determines how many times to multiply
     
@@ -597,19 +770,32 @@ char Algebra::power(char base, char exponent) const {
         return base;
     }
     
-    // General case: multiply base by itself exponent times
-    // exponent's position determines the number of multiplications
-    int expPos = elementPosition.at(exponent);
+    // General case: exponentiation by squaring over the compiled multiplication table
+    // exponent's position is the number of times base is multiplied in
+    int expPos = positionOfElement(exponent);
+    
+    // Scan the exponent bits from the most significant one
+    int highBit = 0;
+    while ((expPos >> (highBit + 1)) != 0) highBit++;
     
     char result = multiplicativeIdentity; // Start with 1
-    for (int i = 0; i < expPos; i++) {
-        result = multiply(result, base);
+    for (int bit = highBit; bit >= 0; bit--) {
+        result = multiply(result, result);
+        if ((expPos >> bit) & 1) {
+            result = multiply(result, base);
+        }
     }
     
     return result;
 }
 
 char Algebra::subtract(char a, char b) const {
+    int cell = tableCell(subtractionTable, a, b);
+    if (cell < 0) return computeSubtract(a, b);
+    return elements[subtractionTable[cell]];
+}
+
+char Algebra::computeSubtract(char a, char b) const {
     // To compute a - b:
     // Find x such that b + x = a
     // We search through all elements to find the appropriate x
@@ -625,6 +811,12 @@ char Algebra::subtract(char a, char b) const {
 }
 
 char Algebra::divide(char a, char b) const {
+    int cell = tableCell(divisionTable, a, b);
+    if (cell < 0) return computeDivide(a, b);
+    return elements[divisionTable[cell]];
+}
+
+char Algebra::computeDivide(char a, char b) const {
     // To compute a / b:
     // Find x such that b * x = a
     // We search through all elements to find the appropriate x
@@ -646,6 +838,12 @@ char Algebra::divide(char a, char b) const {
 }
 
 char Algebra::gcd(char a, char b) const {
+    int cell = tableCell(gcdTable, a, b);
+    if (cell < 0) return computeGcd(a, b);
+    return elements[gcdTable[cell]];
+}
+
+char Algebra::computeGcd(char a, char b) const {
     // GCD (NOD) in finite algebra: largest element d such that
     // d divides both a and b (i.e., exists x, y where d*x = a and d*y = b)
     // We search from the highest position down to find the greatest common divisor
@@ -686,6 +884,12 @@ char Algebra::gcd(char a, char b) const {
 }
 
 char Algebra::lcm(char a, char b) const {
+    int cell = tableCell(lcmTable, a, b);
+    if (cell < 0) return computeLcm(a, b);
+    return elements[lcmTable[cell]];
+}
+
+char Algebra::computeLcm(char a, char b) const {
     // LCM (NOC) in finite algebra: smallest element m such that
     // both a and b divide m (i.e., exists x, y where a*x = m and b*y = m)
     
@@ -719,140 +923,87 @@ char Algebra::lcm(char a, char b) const {
     return elements.back();
 }
 
-void Algebra::printAdditionTable() const {
-    std::cout << "\nAddition Table (+):\n";
-    std::cout << "===================\n";
-    
-    // Print header
-    std::cout << "+    |";
-    for (char e : elements) {
-        std::cout << "  " << e << "    ";
-    }
-    std::cout << "\n-----|";
-    for (size_t i = 0; i < elements.size(); i++) {
-        std::cout << "-------";
+OperationTable Algebra::exportTable(TableKind kind) const {
+    OperationTable table;
+    table.kind = kind;
+    table.elements = elements;
+    table.positions = positionOf;
+    table.positions.resize(elements.size(), -1);  // Before a rule is set nothing is mapped
+    table.labels = positionLabel;
+    
+    table.cells.resize(elements.size() * elements.size());
+    copyTableCells(kind, table.cells.data(), table.cells.size());
+    return table;
+}
+
+size_t Algebra::copyTableCells(TableKind kind, uint8_t* out, size_t capacity) const {
+    const std::vector<uint8_t>* compiled = nullptr;
+    switch (kind) {
+        case TABLE_ADDITION: compiled = &additionTable; break;
+        case TABLE_MULTIPLICATION: compiled = &multiplicationTable; break;
+        case TABLE_SUBTRACTION: compiled = &subtractionTable; break;
+        case TABLE_DIVISION: compiled = &divisionTable; break;
+        case TABLE_ADDITION_CARRY: compiled = &additionCarryTable; break;
+        case TABLE_MULTIPLICATION_CARRY: compiled = &multiplicationCarryTable; break;
+    }
+    
+    size_t cells = elements.size() * elements.size();
+    if (capacity < cells) return cells;
+    if (compiled && compiled->size() == cells) {
+        std::copy(compiled->begin(), compiled->end(), out);
+    } else {
+        // Not compiled yet (or an unknown kind): every cell is 0xFF, which renders as "?"
+        std::fill(out, out + cells, static_cast<uint8_t>(0xFF));
     }
-    std::cout << "\n";
-    
-    // Print rows
-    for (char row : elements) {
-        std::cout << row << "    |";
-        for (char col : elements) {
-            char resultElem = add(row, col);
-            int resultPos = elementPosition.at(resultElem);
-            std::string display = getElementsAtPosition(resultPos);
-            
-            // Center display in 7-char cell
-            int padding = (7 - display.length()) / 2;
-            for (int i = 0; i < padding; i++) std::cout << " ";
-            std::cout << display;
-            for (int i = 0; i < 7 - padding - display.length(); i++) std::cout << " ";
+    return cells;
+}
+
+void Algebra::applyElementwise(TableKind kind, const char* a, const char* b, char* out, size_t count) const {
+    const std::vector<uint8_t>* compiled = nullptr;
+    switch (kind) {
+        case TABLE_ADDITION: compiled = &additionTable; break;
+        case TABLE_MULTIPLICATION: compiled = &multiplicationTable; break;
+        case TABLE_SUBTRACTION: compiled = &subtractionTable; break;
+        case TABLE_DIVISION: compiled = &divisionTable; break;
+        default: throw std::invalid_argument("Not a single-digit operation table");
+    }
+    
+    size_t n = elements.size();
+    if (compiled->size() == n * n && n <= KERNEL_MAX_ELEMENTS) {
+        KernelTable table;
+        prepareKernelTable(compiled->data(), n, elements.data(), table);
+        if (lookupElements(table, a, b, out, count)) return;
+    } else {
+        std::fill(out, out + count, '\0');
+    }
+    
+    // Operands that are not elements (and everything before a rule is set) take
+    // the single-digit operations, with their fallbacks
+    for (size_t i = 0; i < count; i++) {
+        if (out[i] != '\0') continue;
+        switch (kind) {
+            case TABLE_ADDITION: out[i] = add(a[i], b[i]); break;
+            case TABLE_MULTIPLICATION: out[i] = multiply(a[i], b[i]); break;
+            case TABLE_SUBTRACTION: out[i] = subtract(a[i], b[i]); break;
+            default: out[i] = divide(a[i], b[i]); break;
         }
-        std::cout << "\n\n";  // Extra vertical space
     }
-    std::cout << "\n";
+}
+
+void Algebra::printAdditionTable() const {
+    std::cout << renderTable(exportTable(TABLE_ADDITION), FORMAT_TEXT);
 }
 
 void Algebra::printMultiplicationTable() const {
-    std::cout << "\nMultiplication Table (*):\n";
-    std::cout << "=========================\n";
-    
-    // Print header
-    std::cout << "*    |";
-    for (char e : elements) {
-        std::cout << "  " << e << "    ";
-    }
-    std::cout << "\n-----|";
-    for (size_t i = 0; i < elements.size(); i++) {
-        std::cout << "-------";
-    }
-    std::cout << "\n";
-    
-    // Print rows
-    for (char row : elements) {
-        std::cout << row << "    |";
-        for (char col : elements) {
-            char resultElem = multiply(row, col);
-            int resultPos = elementPosition.at(resultElem);
-            std::string display = getElementsAtPosition(resultPos);
-            
-            // Center display in 7-char cell
-            int padding = (7 - display.length()) / 2;
-            for (int i = 0; i < padding; i++) std::cout << " ";
-            std::cout << display;
-            for (int i = 0; i < 7 - padding - display.length(); i++) std::cout << " ";
-        }
-        std::cout << "\n\n";  // Extra vertical space
-    }
-    std::cout << "\n";
+    std::cout << renderTable(exportTable(TABLE_MULTIPLICATION), FORMAT_TEXT);
 }
 
 void Algebra::printSubtractionTable() const {
-    std::cout << "\nSubtraction Table (-):\n";
-    std::cout << "======================\n";
-    
-    // Print header
-    std::cout << "-    |";
-    for (char e : elements) {
-        std::cout << "  " << e << "    ";
-    }
-    std::cout << "\n-----|";
-    for (size_t i = 0; i < elements.size(); i++) {
-        std::cout << "-------";
-    }
-    std::cout << "\n";
-    
-    // Print rows
-    for (char row : elements) {
-        std::cout << row << "    |";
-        for (char col : elements) {
-            char resultElem = subtract(row, col);
-            int resultPos = elementPosition.at(resultElem);
-            std::string display = getElementsAtPosition(resultPos);
-            
-            // Center display in 7-char cell
-            int padding = (7 - display.length()) / 2;
-            for (int i = 0; i < padding; i++) std::cout << " ";
-            std::cout << display;
-            for (int i = 0; i < 7 - padding - display.length(); i++) std::cout << " ";
-        }
-        std::cout << "\n\n";  // Extra vertical space
-    }
-    std::cout << "\n";
+    std::cout << renderTable(exportTable(TABLE_SUBTRACTION), FORMAT_TEXT);
 }
 
 void Algebra::printDivisionTable() const {
-    std::cout << "\nDivision Table (/):\n";
-    std::cout << "===================\n";
-    
-    // Print header
-    std::cout << "/    |";
-    for (char e : elements) {
-        std::cout << "  " << e << "    ";
-    }
-    std::cout << "\n-----|";
-    for (size_t i = 0; i < elements.size(); i++) {
-        std::cout << "-------";
-    }
-    std::cout << "\n";
-    
-    // Print rows
-    for (char row : elements) {
-        std::cout << row << "    |";
-        for (char col : elements) {
-            char resultElem = divide(row, col);
-            int resultPos = elementPosition.at(resultElem);
-            std::string display = getElementsAtPosition(resultPos);
-            
-            // Center display in 7-char cell
-            int padding = (7 - display.length()) / 2;
-            for (int i = 0; i < padding; i++) std::cout << " ";
-            std::cout << display;
-            for (int i = 0; i < 7 - padding - display.length(); i++) std::cout << " ";
-        }
-        std::cout << "\n\n";  // Extra vertical space
-    }
-    std::cout << "\n";
+    std::cout << renderTable(exportTable(TABLE_DIVISION), FORMAT_TEXT);
 }
 
 void Algebra::printMap (){
@@ -862,371 +1013,250 @@ void Algebra::printMap (){
 }
 
 void Algebra::printAdditionCarryTable() const {
-    std::cout << "\nAddition Carry Table:\n";
-    std::cout << "=====================\n";
-    
-    // Print header
-    std::cout << "+    |";
-    for (char e : elements) {
-        std::cout << "  " << e << "    ";
-    }
-    std::cout << "\n-----|";
-    for (size_t i = 0; i < elements.size(); i++) {
-        std::cout << "-------";
-    }
-    std::cout << "\n";
-    
-    // Print rows
-    for (char row : elements) {
-        std::cout << row << "    |";
-        for (char col : elements) {
-            int carry = getAdditionCarry(row, col);
-            
-            std::string display;
-            if (carry > 0) {
-                // Convert carry count to element at that position
-                display = getElementsAtPosition(carry);
-            } else {
-                display = getElementsAtPosition(0);  // 'a' for 0 carries
-            }
-            
-            // Center display in 7-char cell
-            int padding = (7 - display.length()) / 2;
-            for (int i = 0; i < padding; i++) std::cout << " ";
-            std::cout << display;
-            for (int i = 0; i < 7 - padding - display.length(); i++) std::cout << " ";
-        }
-        std::cout << "\n\n";  // Extra vertical space
-    }
-    std::cout << "\n";
+    std::cout << renderTable(exportTable(TABLE_ADDITION_CARRY), FORMAT_TEXT);
 }
 
 void Algebra::printMultiplicationCarryTable() const {
-    std::cout << "\nMultiplication Carry Table:\n";
-    std::cout << "===========================\n";
-    
-    // Print header
-    std::cout << "*    |";
-    for (char e : elements) {
-        std::cout << "  " << e << "    ";
-    }
-    std::cout << "\n-----|";
-    for (size_t i = 0; i < elements.size(); i++) {
-        std::cout << "-------";
-    }
-    std::cout << "\n";
-    
-    // Print rows
-    for (char row : elements) {
-        std::cout << row << "    |";
-        for (char col : elements) {
-            int carry = getMultiplicationCarry(row, col);
-            
-            std::string display;
-            if (carry > 0) {
-                // Convert carry count to element at that position
-                display = getElementsAtPosition(carry);
-            } else {
-                display = getElementsAtPosition(0);  // 'a' for 0 carries
-            }
-            
-            // Center display in 7-char cell
-            int padding = (7 - display.length()) / 2;
-            for (int i = 0; i < padding; i++) std::cout << " ";
-            std::cout << display;
-            for (int i = 0; i < 7 - padding - display.length(); i++) std::cout << " ";
-        }
-        std::cout << "\n\n";  // Extra vertical space
-    }
-    std::cout << "\n";
+    std::cout << renderTable(exportTable(TABLE_MULTIPLICATION_CARRY), FORMAT_TEXT);
 }
 
-std::string Algebra::addArithmetic(const std::string& a, const std::string& b) const {
-    // Add two multi-digit numbers from right to left with carry propagation
-    // Handle negative numbers: -a + b = b - a, a + (-b) = a - b, -a + (-b) = -(a + b)
-    
-    bool aNeg = !a.empty() && a[0] == '-';
-    bool bNeg = !b.empty() && b[0] == '-';
-    
-    std::string aAbs = aNeg ? a.substr(1) : a;
-    std::string bAbs = bNeg ? b.substr(1) : b;
-    
-    // Case 1: -a + (-b) = -(a + b)
-    if (aNeg && bNeg) {
-        std::string result = addArithmetic(aAbs, bAbs);
-        return "-" + result;
+Numeral Algebra::toNumeral(const std::string& value) const {
+    // Parse an element string (optional leading '-') into digit positions
+    Numeral result;
+    size_t start = 0;
+    if (!value.empty() && value[0] == '-') {
+        result.negative = true;
+        start = 1;
     }
     
-    // Case 2: -a + b = b - a
-    if (aNeg && !bNeg) {
-        return subtractArithmetic(bAbs, aAbs);
+    // Most significant digit comes first in the string
+    result.digits.resize(value.length() - start);
+    for (size_t i = start; i < value.length(); i++) {
+        result.digits[value.length() - 1 - i] = static_cast<uint8_t>(positionOfElement(value[i]));
     }
     
-    // Case 3: a + (-b) = a - b
-    if (!aNeg && bNeg) {
-        return subtractArithmetic(aAbs, bAbs);
+    result.trim();
+    return result;
+}
+
+std::string Algebra::fromNumeral(const Numeral& value) const {
+    if (value.isZero()) {
+        return std::string(1, additiveIdentity);
     }
     
-    // Case 4: a + b (both positive)
     std::string result;
-    int carryValue = 0;
-    
-    // Process from right to left
-    int i = aAbs.length() - 1;
-    int j = bAbs.length() - 1;
-    
-    while (i >= 0 || j >= 0 || carryValue > 0) {
-        char digitA = (i >= 0) ? aAbs[i] : additiveIdentity;
-        char digitB = (j >= 0) ? bAbs[j] : additiveIdentity;
-        
-        // Add the two digits
-        int carry1 = 0;
-        char sum = addWithCarry(digitA, digitB, carry1);
-        
-        // Add the carry from previous position
-        int carry2 = 0;
-        for (int c = 0; c < carryValue; c++) {
-            sum = addWithCarry(sum, multiplicativeIdentity, carry2);
-            carry1 += carry2;
-            carry2 = 0;
-        }
-        
-        result = sum + result;  // Prepend to result
-        carryValue = carry1;
-        
-        i--;
-        j--;
+    result.reserve(value.digits.size() + 1);
+    if (value.negative) result += '-';
+    for (size_t i = value.digits.size(); i-- > 0; ) {
+        result += positionElement[value.digits[i]];
     }
-    
-    return clampToBounds(result);
+    return result;
 }
 
-std::string Algebra::subtractArithmetic(const std::string& a, const std::string& b) const {
-    // Subtract two multi-digit numbers using base-n positional arithmetic
-    // Handle negative numbers: a - (-b) = a + b, (-a) - b = -(a + b), (-a) - (-b) = b - a
-    
-    bool aNeg = !a.empty() && a[0] == '-';
-    bool bNeg = !b.empty() && b[0] == '-';
-    
-    std::string aAbs = aNeg ? a.substr(1) : a;
-    std::string bAbs = bNeg ? b.substr(1) : b;
-    
-    // Case 1: a - (-b) = a + b
-    if (!aNeg && bNeg) {
-        return addArithmetic(aAbs, bAbs);
-    }
-    
-    // Case 2: (-a) - b = -(a + b)
-    if (aNeg && !bNeg) {
-        std::string result = addArithmetic(aAbs, bAbs);
-        return "-" + result;
+bool Algebra::toNative(const std::string& value, bool& negative, uint64_t& magnitude) const {
+    // Same parsing as toNumeral, but accumulated into a machine integer
+    const uint64_t base = static_cast<uint64_t>(getCycleLength());
+    const uint64_t limit = std::numeric_limits<uint64_t>::max();
+    size_t start = (!value.empty() && value[0] == '-') ? 1 : 0;
+    
+    magnitude = 0;
+    for (size_t i = start; i < value.length(); i++) {
+        uint64_t digit = static_cast<uint64_t>(positionOfElement(value[i]));
+        if (magnitude > (limit - digit) / base) return false;  // Does not fit 64 bits
+        magnitude = magnitude * base + digit;
+    }
+    negative = start == 1 && magnitude != 0;
+    return true;
+}
+
+std::string Algebra::fromNative(bool negative, uint64_t magnitude) const {
+    if (magnitude == 0) {
+        return std::string(1, additiveIdentity);
     }
     
-    // Case 3: (-a) - (-b) = b - a
-    if (aNeg && bNeg) {
-        return subtractArithmetic(bAbs, aAbs);
+    // Digits from least significant, written right to left
+    const uint64_t base = static_cast<uint64_t>(getCycleLength());
+    char buffer[66];
+    size_t pos = sizeof(buffer);
+    while (magnitude > 0) {
+        buffer[--pos] = positionElement[magnitude % base];
+        magnitude /= base;
     }
-    
-    // Case 4: a - b (both positive)
-    int base = getCycleLength();  // Use actual cycle length, not number of elements
-    
-    // Helper to compare two numbers (returns: 1 if a > b, -1 if a < b, 0 if equal)
-    auto compare = [this](const std::string& a, const std::string& b) -> int {
-        if (a.length() > b.length()) return 1;
-        if (a.length() < b.length()) return -1;
-        
-        for (size_t i = 0; i < a.length(); i++) {
-            int posA = elementPosition.at(a[i]);
-            int posB = elementPosition.at(b[i]);
-            if (posA > posB) return 1;
-            if (posA < posB) return -1;
-        }
-        return 0;
-    };
-    
-    int cmp = compare(aAbs, bAbs);
-    
-    // If a == b, return zero
-    if (cmp == 0) {
-        return std::string(1, additiveIdentity);
+    if (negative) buffer[--pos] = '-';
+    return std::string(buffer + pos, sizeof(buffer) - pos);
+}
+
+std::string Algebra::clampNative(bool negative, uint64_t magnitude) const {
+    std::string result = fromNative(negative, magnitude);
+    if (boundedMode && magnitude != 0 && result.length() - (negative ? 1 : 0) > getMaxValue().length()) {
+        return "преполнение";
     }
-    
-    bool isNegative = false;
-    std::string larger, smaller;
-    
-    // If a < b, result will be negative, swap them
-    if (cmp < 0) {
-        isNegative = true;
-        larger = bAbs;
-        smaller = aAbs;
+    return result;
+}
+
+// Signed sum of native magnitudes, false if it does not fit 64 bits
+static bool addNative(bool aNeg, uint64_t x, bool bNeg, uint64_t y, bool& negative, uint64_t& sum) {
+    if (aNeg == bNeg) {
+        if (x > std::numeric_limits<uint64_t>::max() - y) return false;
+        sum = x + y;
+        negative = aNeg;
+    } else if (x >= y) {
+        sum = x - y;
+        negative = aNeg;
     } else {
-        larger = aAbs;
-        smaller = bAbs;
+        sum = y - x;
+        negative = bNeg;
     }
-    
-    // Do subtraction: larger - smaller
-    std::string result;
-    int borrow = 0;
-    
-    int i = larger.length() - 1;
-    int j = smaller.length() - 1;
-    
-    while (i >= 0 || j >= 0) {
-        int posLarger = (i >= 0) ? elementPosition.at(larger[i]) : 0;
-        int posSmaller = (j >= 0) ? elementPosition.at(smaller[j]) : 0;
-        
-        int diff = posLarger - posSmaller - borrow;
-        
-        if (diff < 0) {
-            diff += base;
-            borrow = 1;
-        } else {
-            borrow = 0;
-        }
-        
-        char digitChar = additiveIdentity;
-        for (const auto& pair : elementPosition) {
-            if (pair.second == diff) {
-                digitChar = pair.first;
-                break;
-            }
+    negative = negative && sum != 0;
+    return true;
+}
+
+// x ^ e by squaring, false if it does not fit 64 bits
+static bool powerNative(uint64_t x, uint64_t e, uint64_t& result) {
+    result = 1;
+    if (x <= 1) {
+        result = e == 0 ? 1 : x;
+        return true;
+    }
+    while (true) {
+        if (e & 1) {
+            if (result > std::numeric_limits<uint64_t>::max() / x) return false;
+            result *= x;
         }
-        
-        result = digitChar + result;
-        i--;
-        j--;
+        e >>= 1;
+        if (e == 0) return true;
+        // Another factor of at least x^2 is still needed
+        if (x > std::numeric_limits<uint32_t>::max()) return false;
+        x *= x;
     }
-    
-    // Remove leading zeros
-    while (result.length() > 1 && result[0] == additiveIdentity) {
-        result = result.substr(1);
+}
+
+// x ^ e mod m for m < 2^32, so every product fits 64 bits
+static uint64_t powModNative(uint64_t x, uint64_t e, uint64_t m) {
+    uint64_t result = 1 % m;
+    x %= m;
+    while (e > 0) {
+        if (e & 1) result = result * x % m;
+        x = x * x % m;
+        e >>= 1;
     }
-    
-    // Add minus sign if negative
-    if (isNegative) {
-        result = "-" + result;
+    return result;
+}
+
+// Operand lengths (in digits) at which the limb backend beats the digit engines:
+// division, GCD and modular power win from short operands on, multiplication
+// only until NTT on digits becomes cheaper than the two conversions
+static const size_t LIMB_DIGITS = 32;
+static const size_t LIMB_MULTIPLY_DIGITS = 128;
+static const size_t LIMB_MULTIPLY_MAX_DIGITS = 2048;
+
+Numeral Algebra::fastMultiply(const Numeral& a, const Numeral& b) const {
+    size_t shorter = std::min(a.digits.size(), b.digits.size());
+    if (shorter < LIMB_MULTIPLY_DIGITS || shorter > LIMB_MULTIPLY_MAX_DIGITS) {
+        return multiplyMagnitude(a, b, getCycleLength());
     }
-    
-    return clampToBounds(result);
+    return radix.fromLimbs(multiplyLimbs(radix.toLimbs(a), radix.toLimbs(b)));
 }
 
-std::string Algebra::multiplyArithmetic(const std::string& a, const std::string& b) const {
-    // Multiply two multi-digit numbers using the standard algorithm
-    // Handle negative numbers: (-a) * (-b) = a * b, (-a) * b = -(a * b), a * (-b) = -(a * b)
-    
-    if (a.empty() || b.empty()) return std::string(1, additiveIdentity);
-    
-    bool aNeg = !a.empty() && a[0] == '-';
-    bool bNeg = !b.empty() && b[0] == '-';
-    
-    std::string aAbs = aNeg ? a.substr(1) : a;
-    std::string bAbs = bNeg ? b.substr(1) : b;
-    
-    // Check if either is zero
-    bool aIsZero = true, bIsZero = true;
-    for (char c : aAbs) if (c != additiveIdentity) aIsZero = false;
-    for (char c : bAbs) if (c != additiveIdentity) bIsZero = false;
-    if (aIsZero || bIsZero) return std::string(1, additiveIdentity);
-    
-    std::string result(1, additiveIdentity);
-    
-    // Multiply absolute values
-    // Multiply aAbs by each digit of bAbs
-    for (int j = bAbs.length() - 1; j >= 0; j--) {
-        std::string partialProduct;
-        int carryValue = 0;
-        
-        // Multiply aAbs by bAbs[j]
-        for (int i = aAbs.length() - 1; i >= 0; i--) {
-            int carry = 0;
-            char product = multiplyWithCarry(aAbs[i], bAbs[j], carry);
-            
-            // Add previous carry
-            int addCarry = 0;
-            for (int c = 0; c < carryValue; c++) {
-                product = addWithCarry(product, multiplicativeIdentity, addCarry);
-                carry += addCarry;
-                addCarry = 0;
-            }
-            
-            partialProduct = product + partialProduct;
-            carryValue = carry;
-        }
-        
-        // Add remaining carries
-        while (carryValue > 0) {
-            int pos = carryValue % getCycleLength();
-            // Find an element at this position (use the first one)
-            char carryChar = additiveIdentity;
-            for (const auto& [elem, p] : elementPosition) {
-                if (p == pos) {
-                    carryChar = elem;
-                    break;
-                }
-            }
-            partialProduct = carryChar + partialProduct;
-            carryValue /= getCycleLength();
-        }
-        
-        // Add zeros for position (shift left)
-        for (int k = j; k < (int)bAbs.length() - 1; k++) {
-            partialProduct += additiveIdentity;
-        }
-        
-        // Add to result
-        result = addArithmetic(result, partialProduct);
+Numeral Algebra::fastDivide(const Numeral& a, const Numeral& b, Numeral& remainder) const {
+    if (b.digits.size() < LIMB_DIGITS) {
+        return divideMagnitude(a, b, getCycleLength(), remainder);
+    }
+    Limbs rest;
+    Limbs quotient = divideLimbs(radix.toLimbs(a), radix.toLimbs(b), rest);
+    remainder = radix.fromLimbs(rest);
+    return radix.fromLimbs(quotient);
+}
+
+Numeral Algebra::fastGcd(const Numeral& a, const Numeral& b) const {
+    if (std::min(a.digits.size(), b.digits.size()) < LIMB_DIGITS) {
+        return gcdMagnitude(a, b, getCycleLength());
+    }
+    return radix.fromLimbs(gcdLimbs(radix.toLimbs(a), radix.toLimbs(b)));
+}
+
+Numeral Algebra::fastPowerMod(const Numeral& value, const Numeral& exponent, const Numeral& modulus) const {
+    // Every step is a reduction by the modulus, so limbs pay off from any length
+    return radix.fromLimbs(powerModLimbs(radix.toLimbs(value), radix.toLimbs(exponent), radix.toLimbs(modulus)));
+}
+
+std::string Algebra::addArithmetic(const std::string& a, const std::string& b) const {
+    // Add two multi-digit numbers as base cycle length integers
+    // Signs are handled by the numeral: -a + b = b - a, a + (-b) = a - b, -a + (-b) = -(a + b)
+    bool aNeg, bNeg, negative;
+    uint64_t x, y, result;
+    if (toNative(a, aNeg, x) && toNative(b, bNeg, y) && addNative(aNeg, x, bNeg, y, negative, result)) {
+        return clampNative(negative, result);
     }
     
-    // Apply sign: negative if signs differ
-    if (aNeg != bNeg) {
-        result = "-" + result;
+    Numeral sum = addNumerals(toNumeral(a), toNumeral(b), getCycleLength());
+    return clampToBounds(sum);
+}
+
+std::string Algebra::subtractArithmetic(const std::string& a, const std::string& b) const {
+    // Subtract two multi-digit numbers using base-n positional arithmetic
+    // Signs are handled by the numeral: a - (-b) = a + b, (-a) - b = -(a + b), (-a) - (-b) = b - a
+    bool aNeg, bNeg, negative;
+    uint64_t x, y, result;
+    if (toNative(a, aNeg, x) && toNative(b, bNeg, y) && addNative(aNeg, x, !bNeg, y, negative, result)) {
+        return clampNative(negative, result);
     }
     
-    return clampToBounds(result);
+    Numeral difference = subtractNumerals(toNumeral(a), toNumeral(b), getCycleLength());
+    return clampToBounds(difference);
+}
+
+std::string Algebra::multiplyArithmetic(const std::string& a, const std::string& b) const {
+    // Multiply two multi-digit numbers using the standard algorithm
+    // Negative if signs differ: (-a) * (-b) = a * b, (-a) * b = -(a * b), a * (-b) = -(a * b)
+    bool aNeg, bNeg;
+    uint64_t x, y;
+    if (toNative(a, aNeg, x) && toNative(b, bNeg, y) &&
+        (y == 0 || x <= std::numeric_limits<uint64_t>::max() / y)) {
+        uint64_t result = x * y;
+        return clampNative(aNeg != bNeg && result != 0, result);
+    }
+    
+    Numeral multiplicand = toNumeral(a);
+    Numeral multiplier = toNumeral(b);
+    Numeral product = fastMultiply(multiplicand, multiplier);
+    product.negative = multiplicand.negative != multiplier.negative && !product.isZero();
+    return clampToBounds(product);
 }
 
 std::string Algebra::divideArithmetic(const std::string& a, const std::string& b, std::string& remainder) const {
-    // Division with remainder using repeated subtraction
-    // quotient = how many times we can subtract b from a
-    // remainder = what's left after all subtractions
-    
-    // Handle negative numbers
-    bool aNeg = !a.empty() && a[0] == '-';
-    bool bNeg = !b.empty() && b[0] == '-';
-    
-    std::string aAbs = aNeg ? a.substr(1) : a;
-    std::string bAbs = bNeg ? b.substr(1) : b;
-    
-    // Helper to check if number is zero
-    auto isZero = [this](const std::string& s) {
-        for (char c : s) {
-            if (c != additiveIdentity) return false;
+    // Division with remainder using long division in base cycle length
+    // quotient = how many times b fits into a
+    // remainder = what's left over
+    
+    // Native fast path for the regular case: non-zero divisor and |a| != |b|
+    bool aNegNative, bNegNative;
+    uint64_t x, y;
+    if (toNative(a, aNegNative, x) && toNative(b, bNegNative, y) && y != 0 && x != y) {
+        if (x < y) {
+            remainder = fromNative(false, x);
+            return std::string(1, additiveIdentity);
         }
-        return true;
-    };
-    
-    // Helper to compare two numbers (returns true if a >= b)
-    auto isGreaterOrEqual = [this](const std::string& a, const std::string& b) {
-        if (a.empty() || b.empty()) return a.length() >= b.length();
-        if (a.length() > b.length()) return true;
-        if (a.length() < b.length()) return false;
-        
-        for (size_t i = 0; i < a.length(); i++) {
-            // Check if character exists in elementPosition
-            if (elementPosition.find(a[i]) == elementPosition.end() ||
-                elementPosition.find(b[i]) == elementPosition.end()) {
-                return false;
-            }
-            int posA = elementPosition.at(a[i]);
-            int posB = elementPosition.at(b[i]);
-            if (posA > posB) return true;
-            if (posA < posB) return false;
+        uint64_t q = x / y;
+        uint64_t r = x % y;
+        bool negative = aNegNative != bNegNative;
+        if (negative && aNegNative && r != 0) {
+            // Euclidean adjustment, same as below
+            q++;
+            r = y - r;
         }
-        return true; // Equal
-    };
+        remainder = fromNative(false, r);
+        return fromNative(negative, q);
+    }
+    
+    int base = getCycleLength();
+    Numeral dividend = toNumeral(a);
+    Numeral divisor = toNumeral(b);
+    bool aNeg = dividend.negative;
+    bool bNeg = divisor.negative;
     
     // Special case: a/a (0/0) should return range [min - max]
-    if (isZero(aAbs) && isZero(bAbs)) {
+    if (dividend.isZero() && divisor.isZero()) {
         std::string minVal = getMinValue();
         std::string maxVal = getMaxValue();
         remainder = std::string(1, additiveIdentity);  // No remainder (zero)
@@ -1234,13 +1264,14 @@ std::string Algebra::divideArithmetic(const std::string& a, const std::string& b
     }
     
     // Check for division by zero (any non-zero number / 0)
-    if (isZero(bAbs)) {
+    if (divisor.isZero()) {
         remainder = "∅";  // Empty set symbol for undefined
         return "∅";  // Return empty set symbol for division by zero
     }
     
     // Special case: x/x, -x/x, or x/-x (same non-zero values) should return range [min - max]
-    if (aAbs == bAbs) {
+    int cmp = compareMagnitude(dividend, divisor);
+    if (cmp == 0) {
         std::string minVal = getMinValue();
         std::string maxVal = getMaxValue();
         remainder = std::string(1, additiveIdentity);  // No remainder
@@ -1248,271 +1279,350 @@ std::string Algebra::divideArithmetic(const std::string& a, const std::string& b
     }
     
     // If a < b, quotient is 0, remainder is a
-    if (!isGreaterOrEqual(aAbs, bAbs)) {
-        remainder = aAbs;
+    dividend.negative = false;
+    divisor.negative = false;
+    if (cmp < 0) {
+        remainder = fromNumeral(dividend);
         return std::string(1, additiveIdentity);
     }
     
-    // Repeatedly subtract b from a and count
-    std::string current = aAbs;
-    std::string quotient(1, additiveIdentity); // Start with 0
+    Numeral current;
+    Numeral quotient = fastDivide(dividend, divisor, current);
+    Numeral one;
+    one.digits.push_back(1);
     
-    int maxIterations = 100000;
-    int iterations = 0;
-    
-    while (isGreaterOrEqual(current, bAbs) && !isZero(current) && iterations < maxIterations) {
-        std::string newCurrent = subtractArithmetic(current, bAbs);
-        
-        // Check if subtraction resulted in negative (shouldn't happen with isGreaterOrEqual check)
-        if (!newCurrent.empty() && newCurrent[0] == '-') {
-            break;
-        }
-        
-        current = newCurrent;
-        
-        // Increment quotient by 1
-        quotient = addArithmetic(quotient, std::string(1, multiplicativeIdentity));
-        
-        iterations++;
-        
-        if (iterations >= maxIterations) {
-            // Hit iteration limit - return what we have
-            break;
-        }
-    }
-    
-    remainder = current;
     //TODO : DONE
     // Apply sign: quotient is negative if signs differ
     if (aNeg != bNeg) {
         // For negative dividend with non-zero remainder, adjust for Euclidean division
-        if (aNeg && !isZero(remainder)) {
+        if (aNeg && !current.isZero()) {
             // Quotient becomes more negative: -(|quotient| + 1)
-            quotient = addArithmetic(quotient, std::string(1, multiplicativeIdentity));
+            quotient = addMagnitude(quotient, one, base);
             // Remainder becomes: divisor - remainder
-            remainder = subtractArithmetic(bAbs, remainder);
+            current = subtractMagnitude(divisor, current, base);
         }
-        quotient = "-" + quotient;
+        quotient.negative = true;
     }
     
-    return quotient;
+    remainder = fromNumeral(current);
+    return fromNumeral(quotient);
 }
 
 std::string Algebra::modArithmetic(const std::string& a, const std::string& b) const {
-    // Calculate a mod b using repeated subtraction
+    // Calculate a mod b using long division
     // a mod b = remainder when a is divided by b
     // For negative numbers, modulo should return positive result
+    bool aNeg, bNeg;
+    uint64_t x, y;
+    if (toNative(a, aNeg, x) && toNative(b, bNeg, y) && y != 0) {
+        return fromNative(false, x % y);
+    }
     
     // Work with absolute values
-    bool aNeg = !a.empty() && a[0] == '-';
-    std::string aAbs = aNeg ? a.substr(1) : a;
-    std::string bAbs = (!b.empty() && b[0] == '-') ? b.substr(1) : b;
-    
-    // Helper to check if number is zero
-    auto isZero = [this](const std::string& s) {
-        for (char c : s) {
-            if (c != additiveIdentity) return false;
-        }
-        return true;
-    };
-    
-    // Helper to compare two numbers (returns true if a >= b)
-    auto isGreaterOrEqual = [this](const std::string& a, const std::string& b) {
-        if (a.empty() || b.empty()) return a.length() >= b.length();
-        if (a.length() > b.length()) return true;
-        if (a.length() < b.length()) return false;
-        
-        // Same length, compare digit by digit
-        for (size_t i = 0; i < a.length(); i++) {
-            // Check if character exists in elementPosition
-            if (elementPosition.find(a[i]) == elementPosition.end() ||
-                elementPosition.find(b[i]) == elementPosition.end()) {
-                return false;
-            }
-            int posA = elementPosition.at(a[i]);
-            int posB = elementPosition.at(b[i]);
-            if (posA > posB) return true;
-            if (posA < posB) return false;
-        }
-        return true; // Equal
-    };
+    Numeral dividend = toNumeral(a);
+    Numeral divisor = toNumeral(b);
+    dividend.negative = false;
+    divisor.negative = false;
     
-    if (isZero(bAbs)) {
+    if (divisor.isZero()) {
         // Modulo by zero is undefined, return a
         return a;
     }
     
-    std::string remainder = aAbs;
-    
-    // Repeatedly subtract bAbs from remainder while remainder >= bAbs
-    int maxIterations = 10000; // Safety limit to prevent infinite loops
-    int iterations = 0;
-    
-    while (isGreaterOrEqual(remainder, bAbs) && !isZero(remainder) && iterations < maxIterations) {
-        std::string newRemainder = subtractArithmetic(remainder, bAbs);
-        
-        // If subtraction resulted in negative or didn't change, we're done
-        if (!newRemainder.empty() && newRemainder[0] == '-') {
-            break;
-        }
-        if (newRemainder == remainder) {
-            break;
-        }
-        
-        remainder = newRemainder;
-        iterations++;
-    }
+    Numeral result;
+    fastDivide(dividend, divisor, result);
     
-    return remainder;
+    return fromNumeral(result);
 }
 
 std::string Algebra::powerArithmetic(const std::string& base, const std::string& exponent) const {
-    // Calculate base ^ exponent using repeated multiplication
+    // Calculate base ^ exponent using exponentiation by squaring
     // Handle negative base: (-a)^n = a^n if n is even, -(a^n) if n is odd
     // Negative exponents not supported (would require division/fractions)
     
+    // Native fast path for the regular case when the power fits 64 bits;
+    // the special cases below keep their own handling
+    bool expNeg, baseNegNative;
+    uint64_t e, x, power;
+    if (toNative(exponent, expNeg, e) && toNative(base, baseNegNative, x) && !expNeg && e != 0 && x != 0 &&
+        !(exponent.length() == 1 && exponent[0] == multiplicativeIdentity) && powerNative(x, e, power)) {
+        return clampNative(baseNegNative && (e & 1), power);
+    }
+    
+    Numeral exp = toNumeral(exponent);
+    
     // Check if exponent is negative
-    if (!exponent.empty() && exponent[0] == '-') {
+    if (exp.negative) {
         // Negative exponent not supported
         return std::string(1, additiveIdentity);  // Return 0
     }
     
-    // Helper to check if number is zero
-    auto isZero = [this](const std::string& s) {
-        for (char c : s) {
-            if (c != additiveIdentity) return false;
-        }
-        return true;
-    };
-    
     // Check if exponent is zero
-    if (isZero(exponent)) {
+    if (exp.isZero()) {
         // Any number to the power of 0 is 1
         return std::string(1, multiplicativeIdentity);
     }
     
     // Check if base is zero
-    if (isZero(base)) {
+    Numeral baseAbs = toNumeral(base);
+    if (baseAbs.isZero()) {
         return std::string(1, additiveIdentity);
     }
     
     // Handle negative base
-    bool baseNeg = !base.empty() && base[0] == '-';
-    std::string baseAbs = baseNeg ? base.substr(1) : base;
+    bool baseNeg = baseAbs.negative;
+    baseAbs.negative = false;
     
     // Check if exponent is 1
     if (exponent.length() == 1 && exponent[0] == multiplicativeIdentity) {
         return base;
     }
     
-    // Use repeated multiplication: base^exp = base * base * ... * base (exp times)
-    std::string result(1, multiplicativeIdentity);  // Start with 1
-    std::string currentPower = baseAbs;
-    std::string remainingExp = exponent;
-    
-    // We'll use a simple approach: multiply result by base, exp times
-    // For efficiency, we could use binary exponentiation, but keep it simple
-    
-    int maxIterations = 10000;  // Safety limit
-    int iterations = 0;
-    
-    // Count down from exponent to 0, multiplying each time
-    while (!isZero(remainingExp) && iterations < maxIterations) {
-        result = multiplyArithmetic(result, baseAbs);
-        
-        // Check if multiplication caused overflow/special result
-        if (result == "преполнение" || result == "∅") {
-            return result;  // Return immediately without further processing
-        }
-        
-        // Decrement remainingExp by 1
-        remainingExp = subtractArithmetic(remainingExp, std::string(1, multiplicativeIdentity));
-        
-        // Check if subtraction resulted in negative (means we're done)
-        if (!remainingExp.empty() && remainingExp[0] == '-') {
-            break;
-        }
-        
-        iterations++;
+    // Exponentiation by squaring driven by the exponent's digits
+    // In bounded mode stop as soon as an intermediate power overflows
+    Numeral result;
+    size_t maxDigits = boundedMode ? getMaxValue().length() : 0;
+    if (!powerMagnitude(baseAbs, exp, getCycleLength(), maxDigits, result)) {
+        return "преполнение";
     }
     
     // Apply sign if base was negative and exponent is odd
-    // But only if result is not a special string
-    if (baseNeg && result != "преполнение" && result != "∅") {
-        // Check if exponent is odd by checking the last digit
-        char lastExpChar = exponent[exponent.length() - 1];
-        if (elementPosition.find(lastExpChar) != elementPosition.end()) {
-            int expLastPos = elementPosition.at(lastExpChar);
-            if (expLastPos % 2 == 1) {
-                result = "-" + result;
-            }
-        }
+    if (baseNeg && isOddMagnitude(exp, getCycleLength())) {
+        result.negative = true;
     }
     
-    return result;  // Result already processed by multiplyArithmetic's clampToBounds
+    return fromNumeral(result);  // Already checked against the bounds above
 }
 
-std::string Algebra::gcdArithmetic(const std::string& a, const std::string& b) const {
-    // Euclidean algorithm: GCD(a, b) = GCD(b, a mod b)
-    // GCD works with absolute values
-    
-    std::string aAbs = (!a.empty() && a[0] == '-') ? a.substr(1) : a;
-    std::string bAbs = (!b.empty() && b[0] == '-') ? b.substr(1) : b;
-    
-    // Helper to check if number is zero
-    auto isZero = [this](const std::string& s) {
-        for (char c : s) {
-            if (c != additiveIdentity) return false;
-        }
-        return true;
-    };
-    
-    std::string num1 = aAbs;
-    std::string num2 = bAbs;
+std::string Algebra::powModArithmetic(const std::string& base, const std::string& exponent, const std::string& modulus) const {
+    // Calculate (base ^ exponent) mod modulus without materializing the power
+    // Same result as modArithmetic(powerArithmetic(base, exponent), modulus), but
+    // every squaring step is reduced, so intermediates stay below modulus^2
+    
+    // Native fast path: products of residues below 2^32 fit 64 bits
+    bool baseNeg, expNeg, modNeg;
+    uint64_t x, e, m;
+    if (toNative(modulus, modNeg, m) && toNative(exponent, expNeg, e) && toNative(base, baseNeg, x) &&
+        m != 0 && m <= std::numeric_limits<uint32_t>::max() && !expNeg) {
+        return fromNative(false, powModNative(x, e, m));
+    }
+    
+    Numeral mod = toNumeral(modulus);
+    mod.negative = false;
+    if (mod.isZero()) {
+        // Modulo by zero is undefined: no residue, like modInverseArithmetic
+        // (never the power itself, which can be arbitrarily large)
+        return "∅";
+    }
     
-    if (isZero(num1)) return num2;
-    if (isZero(num2)) return num1;
+    Numeral exp = toNumeral(exponent);
+    if (exp.negative) {
+        // Negative exponent not supported
+        return std::string(1, additiveIdentity);  // Return 0
+    }
     
-    // Euclidean algorithm using modulo
-    while (!isZero(num2)) {
-        std::string temp = num2;
-        num2 = modArithmetic(num1, num2);
-        num1 = temp;
+    // Like modArithmetic the result is non-negative: |base|^exp mod |modulus|
+    Numeral result = fastPowerMod(toNumeral(base), exp, mod);
+    return fromNumeral(result);
+}
+
+std::string Algebra::gcdArithmetic(const std::string& a, const std::string& b) const {
+    // GCD works with absolute values, GCD(a, 0) = |a|
+    bool aNeg, bNeg;
+    uint64_t x, y;
+    if (toNative(a, aNeg, x) && toNative(b, bNeg, y)) {
+        return fromNative(false, std::gcd(x, y));
     }
     
-    return num1;
+    Numeral divisor = fastGcd(toNumeral(a), toNumeral(b));
+    return fromNumeral(divisor);
 }
 
 std::string Algebra::lcmArithmetic(const std::string& a, const std::string& b) const {
-    // LCM(a, b) = (a * b) / GCD(a, b)
-    // LCM works with absolute values
-    
-    std::string aAbs = (!a.empty() && a[0] == '-') ? a.substr(1) : a;
-    std::string bAbs = (!b.empty() && b[0] == '-') ? b.substr(1) : b;
-    
-    // Check if either is zero
-    auto isZero = [this](const std::string& s) {
-        for (char c : s) {
-            if (c != additiveIdentity) return false;
+    // LCM(a, b) = (|a| / GCD(a, b)) * |b|
+    // Dividing first keeps the intermediate no larger than the result
+    bool aNeg, bNeg;
+    uint64_t xNative, yNative;
+    if (toNative(a, aNeg, xNative) && toNative(b, bNeg, yNative) && xNative != 0 && yNative != 0) {
+        uint64_t reduced = xNative / std::gcd(xNative, yNative);
+        if (reduced <= std::numeric_limits<uint64_t>::max() / yNative) {
+            return clampNative(false, reduced * yNative);
         }
-        return true;
-    };
+    }
     
-    if (isZero(aAbs) || isZero(bAbs)) {
+    Numeral x = toNumeral(a);
+    Numeral y = toNumeral(b);
+    x.negative = false;
+    y.negative = false;
+    
+    if (x.isZero() || y.isZero()) {
         return std::string(1, additiveIdentity);
     }
     
-    // Calculate aAbs * bAbs
-    std::string product = multiplyArithmetic(aAbs, bAbs);
-    
-    // Get GCD
-    std::string gcdResult = gcdArithmetic(aAbs, bAbs);
+    Numeral remainder;
+    Numeral reduced = fastDivide(x, fastGcd(x, y), remainder);
+    return clampToBounds(fastMultiply(reduced, y));
+}
+
+std::string Algebra::extendedGcdArithmetic(const std::string& a, const std::string& b, std::string& x, std::string& y) const {
+    // Bezout coefficients follow the signs of the operands: a * x + b * y = GCD(a, b)
+    Numeral cofactorA;
+    Numeral cofactorB;
+    Numeral divisor = extendedGcd(toNumeral(a), toNumeral(b), getCycleLength(), cofactorA, cofactorB);
+    x = fromNumeral(cofactorA);
+    y = fromNumeral(cofactorB);
+    return fromNumeral(divisor);
+}
+
+std::string Algebra::modInverseArithmetic(const std::string& a, const std::string& modulus) const {
+    // Inverse exists only when GCD(a, m) = 1, it is returned in [0, |m|)
+    int base = getCycleLength();
+    Numeral m = toNumeral(modulus);
+    m.negative = false;
+    if (m.isZero()) return "∅";
+    
+    Numeral x;
+    Numeral y;
+    Numeral divisor = extendedGcd(toNumeral(a), m, base, x, y);
+    if (divisor.digits.size() != 1 || divisor.digits[0] != 1) return "∅";
+    
+    // Bring x into [0, |m|)
+    Numeral remainder;
+    divideMagnitude(x, m, base, remainder);
+    if (x.negative && !remainder.isZero()) {
+        remainder = subtractMagnitude(m, remainder, base);
+    }
+    return fromNumeral(remainder);
+}
+
+NumeralVector Algebra::packNumerals(const std::vector<std::string>& values) const {
+    std::vector<Numeral> numerals;
+    numerals.reserve(values.size());
+    size_t width = 0;
+    for (const std::string& value : values) {
+        numerals.push_back(toNumeral(value));
+        width = std::max(width, numerals.back().digits.size());
+    }
     
-    // Divide product by GCD
+    NumeralVector result;
+    result.resize(values.size(), width);
+    for (size_t i = 0; i < numerals.size(); i++) {
+        result.set(i, numerals[i]);
+    }
+    return result;
+}
+
+std::string Algebra::unpackNumeral(const NumeralVector& values, size_t i) const {
+    return clampToBounds(values.get(i));
+}
+
+std::vector<std::string> Algebra::unpackNumerals(const NumeralVector& values) const {
+    std::vector<std::string> result;
+    result.reserve(values.count);
+    for (size_t i = 0; i < values.count; i++) {
+        result.push_back(unpackNumeral(values, i));
+    }
+    return result;
+}
+
+void Algebra::addVectorArithmetic(const NumeralVector& a, const NumeralVector& b, NumeralVector& out) const {
+    if (a.count != b.count) throw std::invalid_argument("Vectors differ in length");
+    addNumeralVectors(a, b, getCycleLength(), out);
+}
+
+void Algebra::subtractVectorArithmetic(const NumeralVector& a, const NumeralVector& b, NumeralVector& out) const {
+    if (a.count != b.count) throw std::invalid_argument("Vectors differ in length");
+    subtractNumeralVectors(a, b, getCycleLength(), out);
+}
+
+void Algebra::multiplyVectorByDigit(const NumeralVector& a, char digit, NumeralVector& out) const {
+    multiplyNumeralVectorByDigit(a, static_cast<uint8_t>(positionOfElement(digit)), getCycleLength(), out);
+}
+
+std::string Algebra::evaluate(int opcode, const std::string& a, const std::string& b, const std::string& c) const {
     std::string remainder;
-    std::string lcmResult = divideArithmetic(product, gcdResult, remainder);
-    
-    return lcmResult;
+    switch (opcode) {
+        case BATCH_ADD: return addArithmetic(a, b);
+        case BATCH_SUBTRACT: return subtractArithmetic(a, b);
+        case BATCH_MULTIPLY: return multiplyArithmetic(a, b);
+        case BATCH_DIVIDE: return divideArithmetic(a, b, remainder);
+        case BATCH_REMAINDER:
+            divideArithmetic(a, b, remainder);
+            return remainder;
+        case BATCH_MOD: return modArithmetic(a, b);
+        case BATCH_POWER: return powerArithmetic(a, b);
+        case BATCH_POWMOD: return powModArithmetic(a, b, c);
+        case BATCH_GCD: return gcdArithmetic(a, b);
+        case BATCH_LCM: return lcmArithmetic(a, b);
+        case BATCH_MOD_INVERSE: return modInverseArithmetic(a, b);
+    }
+    throw std::invalid_argument("Unknown batch opcode: " + std::to_string(opcode));
+}
+
+// Largest chunk of a parallel batch; smaller batches get smaller chunks, so
+// there are always enough of them to steal when item costs differ widely
+static const size_t BATCH_CHUNK = 64;
+
+void Algebra::evaluateRange(const BatchInput& input, bool format, size_t begin, size_t end,
+                            std::string& text, uint32_t* ends, uint8_t* status) const {
+    std::string operands[BATCH_OPERANDS];
+    for (size_t i = begin; i < end; i++) {
+        const uint32_t* offsets = input.operandOffsets + i * BATCH_OPERANDS;
+        for (int k = 0; k < BATCH_OPERANDS; k++) {
+            operands[k].assign(input.operands + offsets[k], offsets[k + 1] - offsets[k]);
+        }
+        
+        // A failing operation (e.g. an unknown element) reports its error and the batch goes on
+        try {
+            std::string result = evaluate(input.opcodes[i], operands[0], operands[1], operands[2]);
+            text += format ? formatMultiDigitResult(result) : result;
+            status[i] = BATCH_OK;
+        } catch (const std::exception& e) {
+            status[i] = BATCH_ERROR;
+            text += e.what();
+        }
+        ends[i] = static_cast<uint32_t>(text.size());
+    }
+}
+
+void Algebra::evaluateBatch(const BatchInput& input, bool format, BatchOutput& output, ThreadPool* pool) const {
+    size_t count = input.count;
+    output.text.clear();
+    output.offsets.assign(count + 1, 0);
+    output.status.assign(count, BATCH_OK);
+    uint32_t* ends = output.offsets.data() + 1;
+    
+    if (!pool || pool->size() < 2 || count < 2) {
+        evaluateRange(input, format, 0, count, output.text, ends, output.status.data());
+        return;
+    }
+    
+    // Every chunk packs its results into its own buffer (ends relative to it), then
+    // the buffers are joined in order. The algebra is only read by the threads
+    size_t chunkSize = count / (pool->size() * 16);
+    chunkSize = std::max<size_t>(1, std::min(chunkSize, BATCH_CHUNK));
+    size_t chunks = (count + chunkSize - 1) / chunkSize;
+    std::vector<std::string> chunkText(chunks);
+    
+    pool->run(chunks, [&](size_t chunk) {
+        size_t begin = chunk * chunkSize;
+        size_t end = std::min(count, begin + chunkSize);
+        evaluateRange(input, format, begin, end, chunkText[chunk], ends, output.status.data());
+    });
+    
+    size_t total = 0;
+    for (const std::string& text : chunkText) {
+        total += text.size();
+    }
+    output.text.reserve(total);
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        uint32_t base = static_cast<uint32_t>(output.text.size());
+        size_t end = std::min(count, (chunk + 1) * chunkSize);
+        for (size_t i = chunk * chunkSize; i < end; i++) {
+            ends[i] += base;
+        }
+        output.text += chunkText[chunk];
+    }
 }
 
 std::string Algebra::getMaxValue() const {
@@ -1540,52 +1650,23 @@ std::string Algebra::getMinValue() const {
     return "-" + getMaxValue();
 }
 
-bool Algebra::exceedsBounds(const std::string& value) const {
+bool Algebra::exceedsBounds(const Numeral& value) const {
     if (!boundedMode) return false;
     
-    // Helper to check if number is zero
-    auto isZero = [this](const std::string& s) {
-        for (char c : s) {
-            if (c != additiveIdentity) return false;
-        }
-        return true;
-    };
-    
     // Zero is always within bounds
-    if (isZero(value)) return false;
-    
-    bool isNeg = !value.empty() && value[0] == '-';
-    std::string absValue = isNeg ? value.substr(1) : value;
-    std::string maxAbs = getMaxValue();
+    if (value.isZero()) return false;
     
-    // Check length first
-    if (absValue.length() > maxAbs.length()) return true;
-    if (absValue.length() < maxAbs.length()) return false;
-    
-    // Same length - compare element by element
-    for (size_t i = 0; i < absValue.length(); i++) {
-        if (elementPosition.find(absValue[i]) == elementPosition.end() ||
-            elementPosition.find(maxAbs[i]) == elementPosition.end()) {
-            return false;
-        }
-        int posVal = elementPosition.at(absValue[i]);
-        int posMax = elementPosition.at(maxAbs[i]);
-        if (posVal > posMax) return true;
-        if (posVal < posMax) return false;
-    }
-    
-    return false; // Equal to max, which is OK
+    // The maximum repeats the highest position in every digit, so any
+    // value with no more digits than the maximum is within bounds
+    return value.digits.size() > getMaxValue().length();
 }
 
-std::string Algebra::clampToBounds(const std::string& value) const {
-    if (!boundedMode) return value;
+std::string Algebra::clampToBounds(const Numeral& value) const {
+    if (!boundedMode) return fromNumeral(value);
     
     // Check if value exceeds bounds
-    if (!exceedsBounds(value)) return value;
+    if (!exceedsBounds(value)) return fromNumeral(value);
     
     // Return overflow message instead of clamping to max/min
     return "преполнение";
 }
-
-
-
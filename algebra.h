@@ -4,6 +4,14 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <cstdint>
+#include "numeral.h"
+#include "limbs.h"
+#include "table_export.h"
+#include "batch.h"
+#include "thread_pool.h"
+#include "element_kernels.h"
+#include "numeral_vector.h"
 
 class Algebra {
 private:
@@ -16,30 +24,72 @@ private:
     bool boundedMode;                                // Enable/disable bounded arithmetic
     int bits;                                        // Number of elements (algebra size)
     
-    // Operation tables
-    std::map<std::pair<char, char>, char> additionTable;
-    std::map<std::pair<char, char>, char> multiplicationTable;
-    std::map<std::pair<char, char>, char> subtractionTable;
-    std::map<std::pair<char, char>, char> divisionTable;
+    // Position index, precomputed in setPlusOneRule
+    std::vector<int> successor;                      // Element id -> id of its +1 representative (-1 if none)
+    std::vector<int> positionOf;                     // Element id -> position in the cycle (-1 if unmapped)
+    std::vector<char> positionElement;               // Position -> representative element
+    std::vector<std::string> positionLabel;          // Position -> display label: "d", or "{d,f}" for a shared position
+    int cycleLength;                                 // Number of distinct positions
+    
+    // Operation tables, compiled in setPlusOneRule
+    // Dense row-major n x n arrays indexed by element id (elements[id]), cell = id(a) * n + id(b)
+    std::vector<uint8_t> additionTable;              // Result element ids
+    std::vector<uint8_t> multiplicationTable;
+    std::vector<uint8_t> subtractionTable;
+    std::vector<uint8_t> divisionTable;
+    std::vector<uint8_t> powerTable;                 // base ^ exponent
+    std::vector<uint8_t> gcdTable;
+    std::vector<uint8_t> lcmTable;
     
     // Carry tables (track how many times we overflow the cycle)
-    //can easily change to map::<pair<char,char> char> (also count the cycles using the same algebra)
-    std::map<std::pair<char, char>, int> additionCarryTable;
-    std::map<std::pair<char, char>, int> multiplicationCarryTable;
+    std::vector<uint8_t> additionCarryTable;
+    std::vector<uint8_t> multiplicationCarryTable;
     
     // Helper methods
     //char Add(char elem1, char elem2); 
+    void buildSuccessors();
     void BuildHasse();
+    void buildPositionIndex();
     void buildAdditionTable();
     void buildMultiplicationTable();
     void buildSubtractionTable();
     void buildDivisionTable();
-    char addMultipleTimes(char element, int times) const;
+    void buildPowerTable();
+    void buildGcdLcmTables();
     char addMultipleTimesWithCarry(char element, int times, int& carry) const;
+    int elementId(char element) const;  // Dense id of element (0..n-1), or -1 if not an element
+    int positionOfElement(char element) const;  // Position in the cycle, throws std::out_of_range if unmapped
+    int tableCell(const std::vector<uint8_t>& table, char a, char b) const;  // Cell index, or -1 if not compiled/invalid
+    
+    // Rule-based evaluation, used to compile the tables (and as fallback before a rule is set)
+    char computeAddWithCarry(char a, char b, int& carry) const;
+    char computeMultiplyWithCarry(char a, char b, int& carry) const;
+    char computeSubtract(char a, char b) const;
+    char computeDivide(char a, char b) const;
+    char computePower(char base, char exponent) const;
+    char computeGcd(char a, char b) const;
+    char computeLcm(char a, char b) const;
     std::string getElementsAtPosition(int position) const;  // Returns formatted string of elements at position
     int getCycleLength() const;  // Returns the number of distinct positions in the cycle
-    std::string clampToBounds(const std::string& value) const;  // Clamp value to min/max bounds
-    bool exceedsBounds(const std::string& value) const;  // Check if value exceeds bounds
+    std::string clampToBounds(const Numeral& value) const;  // Format value, or the overflow marker if out of bounds
+    bool exceedsBounds(const Numeral& value) const;  // Check if value exceeds bounds
+    Numeral toNumeral(const std::string& value) const;  // Parse element string (optional leading '-')
+    std::string fromNumeral(const Numeral& value) const;  // Element string, additive identity for zero
+    
+    // Native fast path: numerals whose magnitude fits 64 bits are computed as machine integers
+    bool toNative(const std::string& value, bool& negative, uint64_t& magnitude) const;  // false if it does not fit
+    std::string fromNative(bool negative, uint64_t magnitude) const;
+    std::string clampNative(bool negative, uint64_t magnitude) const;  // fromNative, or the overflow marker if out of bounds
+    
+    // Limb backend: long operands are converted to base 2^32 and back, with the
+    // powers of the cycle length cached per algebra (reset in setPlusOneRule)
+    RadixConverter radix;
+    Numeral fastMultiply(const Numeral& a, const Numeral& b) const;  // |a| * |b|
+    Numeral fastDivide(const Numeral& a, const Numeral& b, Numeral& remainder) const;  // |a| / |b|, requires b != 0
+    Numeral fastGcd(const Numeral& a, const Numeral& b) const;
+    Numeral fastPowerMod(const Numeral& value, const Numeral& exponent, const Numeral& modulus) const;  // Requires modulus != 0
+    void evaluateRange(const BatchInput& input, bool format, size_t begin, size_t end,
+                       std::string& text, uint32_t* ends, uint8_t* status) const;  // Items [begin, end) appended to text
     //void bitLimiter()
 public:
     // Constructor
@@ -72,17 +122,55 @@ public:
     int getMultiplicationCarry(char a, char b) const;
     
     // Multi-digit arithmetic operations
+    // All const methods only read the compiled algebra (the limb backend's power cache
+    // is locked), so one Algebra can serve many threads until setPlusOneRule is called again.
+    // SharedAlgebra (shared_algebra.h) reconfigures without that restriction
     std::string addArithmetic(const std::string& a, const std::string& b) const;
     std::string subtractArithmetic(const std::string& a, const std::string& b) const;
     std::string multiplyArithmetic(const std::string& a, const std::string& b) const;
     std::string divideArithmetic(const std::string& a, const std::string& b, std::string& remainder) const;
     std::string powerArithmetic(const std::string& base, const std::string& exponent) const;  // base ^ exponent
     std::string modArithmetic(const std::string& a, const std::string& b) const;  // a mod b
+    std::string powModArithmetic(const std::string& base, const std::string& exponent, const std::string& modulus) const;  // (base ^ exponent) mod modulus, "∅" for a zero modulus
     std::string formatMultiDigitResult(const std::string& result) const;  // Format result with braces for equivalent elements
     std::string gcdArithmetic(const std::string& a, const std::string& b) const;  // Multi-digit GCD/NOD
     std::string lcmArithmetic(const std::string& a, const std::string& b) const;  // Multi-digit LCM/NOC
+    std::string extendedGcdArithmetic(const std::string& a, const std::string& b, std::string& x, std::string& y) const;  // GCD with a * x + b * y = GCD
+    std::string modInverseArithmetic(const std::string& a, const std::string& modulus) const;  // x with a * x = 1 mod modulus, "∅" if none
+    
+    // Vector arithmetic over numerals in structure-of-arrays layout (numeral_vector.h):
+    // element-wise over all numerals of the vectors at once. Results keep every digit;
+    // in bounded mode unpackNumeral reports the overflow of a numeral, like the string operations
+    NumeralVector packNumerals(const std::vector<std::string>& values) const;
+    std::string unpackNumeral(const NumeralVector& values, size_t i) const;
+    std::vector<std::string> unpackNumerals(const NumeralVector& values) const;
+    void addVectorArithmetic(const NumeralVector& a, const NumeralVector& b, NumeralVector& out) const;
+    void subtractVectorArithmetic(const NumeralVector& a, const NumeralVector& b, NumeralVector& out) const;
+    void multiplyVectorByDigit(const NumeralVector& a, char digit, NumeralVector& out) const;  // digit is an element
+    
+    // Batch evaluation: every operation of the batch evaluated in one call, results
+    // (formatted with formatMultiDigitResult if format is set) packed into output in order.
+    // With a pool the batch is split into chunks that the pool's threads share
+    std::string evaluate(int opcode, const std::string& a, const std::string& b, const std::string& c) const;  // One BatchOpcode, throws on errors
+    void evaluateBatch(const BatchInput& input, bool format, BatchOutput& output, ThreadPool* pool = nullptr) const;
+    
+    // Table export: a snapshot of one compiled table, rendered by renderTable (table_export.h)
+    OperationTable exportTable(TableKind kind) const;
+    size_t copyTableCells(TableKind kind, uint8_t* out, size_t capacity) const;  // n x n cells only; returns n * n, fills out if it fits
+    
+    // Compiled image (algebra_image.h): the compiled algebra as a binary file that
+    // loads without recompiling. Bounded mode is not part of the image
+    std::string serializeImage() const;  // Throws std::runtime_error before a rule is set
+    void saveImage(const std::string& path) const;  // Throws std::runtime_error if it cannot be written
+    void loadImage(const uint8_t* data, size_t size);  // Replaces the compiled algebra; throws std::runtime_error if data is not a valid image
+    void loadImage(const std::string& path);  // Maps the file
+    
+    // Element-wise single-digit operation over arrays: out[i] = a[i] op b[i] for the
+    // addition, multiplication, subtraction or division table, by the SIMD kernels
+    // (element_kernels.h). Same results as add/multiply/subtract/divide per element
+    void applyElementwise(TableKind kind, const char* a, const char* b, char* out, size_t count) const;
     
-    // Print tables
+    // Print tables (text rendering of exportTable)
     void printAdditionTable() const;
     void printMultiplicationTable() const;
     void printSubtractionTable() const;
@@ -94,6 +182,7 @@ public:
     const std::vector<char>& getElements() const { return elements; }
     const std::vector<std::vector<char>>& getPlusOneRule() const { return plusOneRule; }
     const std::map<char, int>& getElementPosition() const { return elementPosition; }
+    int getBits() const { return bits; }
     
     // Bounded mode control
     void setBoundedMode(bool enabled) { boundedMode = enabled; }
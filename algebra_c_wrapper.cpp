@@ -4,112 +4,491 @@
  */
 
 #include "algebra.h"
+#include "algebra_cache.h"
+#include "shared_algebra.h"
 #include <cstring>
+#include <algorithm>
+#include <memory>
+#include <limits>
+#include <stdexcept>
+
+// A handle: the algebra as published snapshots (shared_algebra.h) plus the full text
+// of the last results returned through it. Every call loads the current snapshot once
+// and uses it throughout, so calculations run while another thread reconfigures the
+// handle. The result slots belong to the handle: threads calculating at the same time
+// take a handle each with algebra_snapshot
+struct AlgebraContext {
+    explicit AlgebraContext(int bits) : algebra(bits) {}
+    explicit AlgebraContext(std::shared_ptr<const Algebra> snapshot) : algebra(std::move(snapshot)) {}
+    SharedAlgebra algebra;
+    std::string results[3];  // Result / quotient / GCD, remainder / x, y
+    BatchOutput batch;       // Results of the last batch
+    
+    // Pool that evaluates batches: the shared one (default, not owned), a private one,
+    // or none (serial). Swapped atomically too, so a running batch keeps its pool
+    std::shared_ptr<ThreadPool> pool = std::shared_ptr<ThreadPool>(std::shared_ptr<ThreadPool>(), &ThreadPool::shared());
+};
+
+static AlgebraContext* contextOf(void* handle) {
+    return static_cast<AlgebraContext*>(handle);
+}
+
+static std::shared_ptr<const Algebra> snapshotOf(void* handle) {
+    return contextOf(handle)->algebra.snapshot();
+}
+
+// Keeps value in the handle's result slot and copies as much as fits into
+// result (NUL-terminated). Returns the full length, so callers can pass a
+// null buffer to query it, or read the slot without calling again
+static int storeResult(void* handle, int slot, std::string& value, char* result, int result_size) {
+    std::string& stored = contextOf(handle)->results[slot];
+    stored.swap(value);
+    if (result && result_size > 0) {
+        size_t count = std::min(stored.size(), static_cast<size_t>(result_size - 1));
+        std::memcpy(result, stored.data(), count);
+        result[count] = '\0';
+    }
+    return static_cast<int>(stored.size());
+}
+
+// A failed calculation: its error text goes to result slot 0 (like a result) and
+// the entry point returns -1, so no exception crosses into the C caller
+static int storeError(void* handle, const std::exception& e) {
+    std::string error = e.what();
+    storeResult(handle, 0, error, nullptr, 0);
+    return -1;
+}
 
 extern "C" {
     // Opaque pointer type for Algebra object
     typedef void* AlgebraHandle;
     
-    // Create new Algebra instance
+    // Create new Algebra instance (null if it cannot be allocated)
     AlgebraHandle algebra_create(int bits) {
-        return new Algebra(bits);
+        try {
+            return new AlgebraContext(bits);
+        } catch (const std::exception&) {
+            return nullptr;
+        }
+    }
+    
+    // A new handle on the current snapshot of handle, for one thread's calculations:
+    // it keeps that snapshot (and the batch threads setting) whatever happens to handle
+    // later, and has its own result slots. Destroy it with algebra_destroy.
+    // Null if it cannot be allocated
+    AlgebraHandle algebra_snapshot(AlgebraHandle handle) {
+        try {
+            AlgebraContext* snapshot = new AlgebraContext(snapshotOf(handle));
+            snapshot->pool = std::atomic_load(&contextOf(handle)->pool);
+            return snapshot;
+        } catch (const std::exception&) {
+            return nullptr;
+        }
     }
     
     // Destroy Algebra instance
     void algebra_destroy(AlgebraHandle handle) {
-        delete static_cast<Algebra*>(handle);
+        delete contextOf(handle);
     }
     
-    // Set plus one rule
-    void algebra_set_plus_one_rule(AlgebraHandle handle, const char* rule) {
-        static_cast<Algebra*>(handle)->setPlusOneRule(std::string(rule));
+    // Result API: every function that produces text returns its full length in bytes
+    // (without the NUL) and copies at most size - 1 bytes into the caller's buffer.
+    // They return -1 if the calculation fails (e.g. a digit that is not an element),
+    // with the error text in slot 0; no exception ever reaches the caller.
+    // Pass a null buffer to query the length. The full text also stays in the handle
+    // until the next call that produces a result in the same slot: slot 0 is the
+    // result (quotient, GCD), slot 1 the remainder or x, slot 2 y
+    const char* algebra_last_result(AlgebraHandle handle, int slot) {
+        if (slot < 0 || slot > 2) return "";
+        return contextOf(handle)->results[slot].c_str();
     }
     
-    // Set bounded mode
-    void algebra_set_bounded_mode(AlgebraHandle handle, bool enabled) {
-        static_cast<Algebra*>(handle)->setBoundedMode(enabled);
+    int algebra_last_result_length(AlgebraHandle handle, int slot) {
+        if (slot < 0 || slot > 2) return 0;
+        return static_cast<int>(contextOf(handle)->results[slot].size());
+    }
+    
+    // Set plus one rule: the compiled algebra comes from the process-wide cache
+    // (algebra_cache.h), so a rule seen before is not compiled again.
+    // Returns 1, or 0 with the error in result slot 0 if the rule cannot be compiled
+    // (the handle keeps its algebra then)
+    int algebra_set_plus_one_rule(AlgebraHandle handle, const char* rule) {
+        try {
+            contextOf(handle)->algebra.setPlusOneRule(std::string(rule));
+            return 1;
+        } catch (const std::exception& e) {
+            std::string error = e.what();
+            storeResult(handle, 0, error, nullptr, 0);
+            return 0;
+        }
+    }
+    
+    // Replace the algebra by bits elements with the rule, bounded mode off, in one step.
+    // Returns like algebra_set_plus_one_rule
+    int algebra_configure(AlgebraHandle handle, int bits, const char* rule) {
+        try {
+            contextOf(handle)->algebra.configure(bits, std::string(rule));
+            return 1;
+        } catch (const std::exception& e) {
+            std::string error = e.what();
+            storeResult(handle, 0, error, nullptr, 0);
+            return 0;
+        }
+    }
+    
+    // Number of compiled algebras the cache keeps (0 disables it)
+    void algebra_cache_set_capacity(int capacity) {
+        AlgebraCache::shared().setCapacity(capacity < 0 ? 0 : static_cast<size_t>(capacity));
+    }
+    
+    int algebra_cache_size() {
+        return static_cast<int>(AlgebraCache::shared().size());
+    }
+    
+    // Compiled images (algebra_image.h). Return 1 on success, 0 if the file cannot
+    // be written or read, or is not a valid image (the handle is then unchanged)
+    int algebra_save_image(AlgebraHandle handle, const char* path) {
+        try {
+            snapshotOf(handle)->saveImage(std::string(path));
+            return 1;
+        } catch (const std::exception&) {
+            return 0;
+        }
+    }
+    
+    int algebra_load_image(AlgebraHandle handle, const char* path) {
+        try {
+            contextOf(handle)->algebra.loadImage(std::string(path));
+            return 1;
+        } catch (const std::exception&) {
+            return 0;
+        }
+    }
+    
+    // Adds an image to the cache: algebra_set_plus_one_rule with its bits and rule
+    // then copies it instead of compiling
+    int algebra_cache_preload(const char* path) {
+        try {
+            AlgebraCache::shared().preload(std::string(path));
+            return 1;
+        } catch (const std::exception&) {
+            return 0;
+        }
+    }
+    
+    // Set bounded mode. Returns like algebra_set_plus_one_rule
+    int algebra_set_bounded_mode(AlgebraHandle handle, bool enabled) {
+        try {
+            contextOf(handle)->algebra.setBoundedMode(enabled);
+            return 1;
+        } catch (const std::exception& e) {
+            storeError(handle, e);
+            return 0;
+        }
     }
     
     // Get bounded mode
     bool algebra_get_bounded_mode(AlgebraHandle handle) {
-        return static_cast<Algebra*>(handle)->isBoundedMode();
+        return snapshotOf(handle)->isBoundedMode();
     }
     
     // Add arithmetic (multi-digit)
-    void algebra_add_arithmetic(AlgebraHandle handle, const char* a, const char* b, char* result, int result_size) {
-        std::string res = static_cast<Algebra*>(handle)->addArithmetic(std::string(a), std::string(b));
-        strncpy(result, res.c_str(), result_size - 1);
-        result[result_size - 1] = '\0';
+    int algebra_add_arithmetic(AlgebraHandle handle, const char* a, const char* b, char* result, int result_size) {
+        try {
+            std::string res = snapshotOf(handle)->addArithmetic(std::string(a), std::string(b));
+            return storeResult(handle, 0, res, result, result_size);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
     }
     
     // Subtract arithmetic
-    void algebra_subtract_arithmetic(AlgebraHandle handle, const char* a, const char* b, char* result, int result_size) {
-        std::string res = static_cast<Algebra*>(handle)->subtractArithmetic(std::string(a), std::string(b));
-        strncpy(result, res.c_str(), result_size - 1);
-        result[result_size - 1] = '\0';
+    int algebra_subtract_arithmetic(AlgebraHandle handle, const char* a, const char* b, char* result, int result_size) {
+        try {
+            std::string res = snapshotOf(handle)->subtractArithmetic(std::string(a), std::string(b));
+            return storeResult(handle, 0, res, result, result_size);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
     }
     
     // Multiply arithmetic
-    void algebra_multiply_arithmetic(AlgebraHandle handle, const char* a, const char* b, char* result, int result_size) {
-        std::string res = static_cast<Algebra*>(handle)->multiplyArithmetic(std::string(a), std::string(b));
-        strncpy(result, res.c_str(), result_size - 1);
-        result[result_size - 1] = '\0';
+    int algebra_multiply_arithmetic(AlgebraHandle handle, const char* a, const char* b, char* result, int result_size) {
+        try {
+            std::string res = snapshotOf(handle)->multiplyArithmetic(std::string(a), std::string(b));
+            return storeResult(handle, 0, res, result, result_size);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
     }
     
     // Divide arithmetic
-    void algebra_divide_arithmetic(AlgebraHandle handle, const char* a, const char* b, 
-                                   char* quotient, int q_size, char* remainder, int r_size) {
-        std::string rem;
-        std::string quot = static_cast<Algebra*>(handle)->divideArithmetic(std::string(a), std::string(b), rem);
-        strncpy(quotient, quot.c_str(), q_size - 1);
-        quotient[q_size - 1] = '\0';
-        strncpy(remainder, rem.c_str(), r_size - 1);
-        remainder[r_size - 1] = '\0';
+    int algebra_divide_arithmetic(AlgebraHandle handle, const char* a, const char* b, 
+                                  char* quotient, int q_size, char* remainder, int r_size) {
+        try {
+            std::string rem;
+            std::string quot = snapshotOf(handle)->divideArithmetic(std::string(a), std::string(b), rem);
+            storeResult(handle, 1, rem, remainder, r_size);
+            return storeResult(handle, 0, quot, quotient, q_size);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
     }
     
     // Power arithmetic
-    void algebra_power_arithmetic(AlgebraHandle handle, const char* base, const char* exp, char* result, int result_size) {
-        std::string res = static_cast<Algebra*>(handle)->powerArithmetic(std::string(base), std::string(exp));
-        strncpy(result, res.c_str(), result_size - 1);
-        result[result_size - 1] = '\0';
+    int algebra_power_arithmetic(AlgebraHandle handle, const char* base, const char* exp, char* result, int result_size) {
+        try {
+            std::string res = snapshotOf(handle)->powerArithmetic(std::string(base), std::string(exp));
+            return storeResult(handle, 0, res, result, result_size);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
     }
     
     // Mod arithmetic
-    void algebra_mod_arithmetic(AlgebraHandle handle, const char* a, const char* b, char* result, int result_size) {
-        std::string res = static_cast<Algebra*>(handle)->modArithmetic(std::string(a), std::string(b));
-        strncpy(result, res.c_str(), result_size - 1);
-        result[result_size - 1] = '\0';
+    int algebra_mod_arithmetic(AlgebraHandle handle, const char* a, const char* b, char* result, int result_size) {
+        try {
+            std::string res = snapshotOf(handle)->modArithmetic(std::string(a), std::string(b));
+            return storeResult(handle, 0, res, result, result_size);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
+    }
+    
+    // PowMod arithmetic: (base ^ exp) mod modulus
+    int algebra_powmod_arithmetic(AlgebraHandle handle, const char* base, const char* exp, const char* modulus, char* result, int result_size) {
+        try {
+            std::string res = snapshotOf(handle)->powModArithmetic(std::string(base), std::string(exp), std::string(modulus));
+            return storeResult(handle, 0, res, result, result_size);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
     }
     
     // GCD arithmetic
-    void algebra_gcd_arithmetic(AlgebraHandle handle, const char* a, const char* b, char* result, int result_size) {
-        std::string res = static_cast<Algebra*>(handle)->gcdArithmetic(std::string(a), std::string(b));
-        strncpy(result, res.c_str(), result_size - 1);
-        result[result_size - 1] = '\0';
+    int algebra_gcd_arithmetic(AlgebraHandle handle, const char* a, const char* b, char* result, int result_size) {
+        try {
+            std::string res = snapshotOf(handle)->gcdArithmetic(std::string(a), std::string(b));
+            return storeResult(handle, 0, res, result, result_size);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
     }
     
     // LCM arithmetic
-    void algebra_lcm_arithmetic(AlgebraHandle handle, const char* a, const char* b, char* result, int result_size) {
-        std::string res = static_cast<Algebra*>(handle)->lcmArithmetic(std::string(a), std::string(b));
-        strncpy(result, res.c_str(), result_size - 1);
-        result[result_size - 1] = '\0';
+    int algebra_lcm_arithmetic(AlgebraHandle handle, const char* a, const char* b, char* result, int result_size) {
+        try {
+            std::string res = snapshotOf(handle)->lcmArithmetic(std::string(a), std::string(b));
+            return storeResult(handle, 0, res, result, result_size);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
+    }
+    
+    // Extended GCD: returns GCD and Bezout coefficients x, y with a * x + b * y = GCD
+    int algebra_extended_gcd_arithmetic(AlgebraHandle handle, const char* a, const char* b,
+                                        char* gcd, int g_size, char* x, int x_size, char* y, int y_size) {
+        try {
+            std::string coefX;
+            std::string coefY;
+            std::string res = snapshotOf(handle)->extendedGcdArithmetic(std::string(a), std::string(b), coefX, coefY);
+            storeResult(handle, 1, coefX, x, x_size);
+            storeResult(handle, 2, coefY, y, y_size);
+            return storeResult(handle, 0, res, gcd, g_size);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
+    }
+    
+    // Modular inverse of a modulo modulus
+    int algebra_mod_inverse_arithmetic(AlgebraHandle handle, const char* a, const char* modulus, char* result, int result_size) {
+        try {
+            std::string res = snapshotOf(handle)->modInverseArithmetic(std::string(a), std::string(modulus));
+            return storeResult(handle, 0, res, result, result_size);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
     }
     
     // Format result
-    void algebra_format_result(AlgebraHandle handle, const char* input, char* result, int result_size) {
-        std::string res = static_cast<Algebra*>(handle)->formatMultiDigitResult(std::string(input));
-        strncpy(result, res.c_str(), result_size - 1);
-        result[result_size - 1] = '\0';
+    int algebra_format_result(AlgebraHandle handle, const char* input, char* result, int result_size) {
+        try {
+            std::string res = snapshotOf(handle)->formatMultiDigitResult(std::string(input));
+            return storeResult(handle, 0, res, result, result_size);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
+    }
+    
+    // Element-wise single-digit operation over count elements: out[i] = a[i] op b[i]
+    // with kind 0-3 as in algebra_export_table (+, *, -, /). out is not NUL-terminated.
+    // Returns count, or -1 for an invalid kind or count, or an operand that is not an
+    // element (error text in result slot 0; out is then partly filled)
+    int algebra_apply_elementwise(AlgebraHandle handle, int kind, const char* a, const char* b, char* out, int count) {
+        if (kind < TABLE_ADDITION || kind > TABLE_DIVISION || count < 0) {
+            return storeError(handle, std::invalid_argument("Not a single-digit operation or count"));
+        }
+        try {
+            snapshotOf(handle)->applyElementwise(static_cast<TableKind>(kind), a, b, out, static_cast<size_t>(count));
+            return count;
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
+    }
+    
+    // Instruction set of the element-wise kernels: "scalar", "ssse3", "avx2" or "avx512"
+    const char* algebra_kernel_isa() {
+        return kernelIsaName(getKernelIsa());
+    }
+    
+    // Use at most the given instruction set (0 scalar .. 3 AVX-512); returns the one in use
+    int algebra_set_kernel_isa(int isa) {
+        return setKernelIsa(static_cast<KernelIsa>(isa < 0 ? 0 : isa));
+    }
+    
+    // Evaluate count operations in one call. opcodes are BatchOpcode values; operand k (a, b, c)
+    // of operation i is operands[operand_offsets[3 * i + k], operand_offsets[3 * i + k + 1]).
+    // With format set results are formatted like algebra_format_result.
+    // result_offsets (count + 1 entries) and status (count entries, BatchStatus) are always
+    // filled; the packed results are copied to out only if they fit in out_cap bytes, otherwise
+    // algebra_copy_batch_results fetches them without evaluating again.
+    // operand_offsets (3 * count + 1 entries) must not decrease, and operands must hold at
+    // least operand_offsets[3 * count] bytes; only the buffer's size cannot be checked here.
+    // Returns the total length of the results, or -1 for invalid arguments, results
+    // longer than INT_MAX or a failed evaluation (nothing is filled then; the error text
+    // is in result slot 0). Errors of single operations are reported in status instead
+    int algebra_evaluate_batch(AlgebraHandle handle, int count, const uint8_t* opcodes, const char* operands,
+                               const uint32_t* operand_offsets, int format,
+                               char* out, int out_cap, uint32_t* result_offsets, uint8_t* status) {
+        if (count < 0 || !result_offsets || (count > 0 && (!opcodes || !operand_offsets || !status))) {
+            return storeError(handle, std::invalid_argument("Invalid batch arguments"));
+        }
+        if (count > 0) {
+            size_t last = 3 * static_cast<size_t>(count);
+            for (size_t k = 0; k < last; k++) {
+                if (operand_offsets[k] > operand_offsets[k + 1]) {
+                    return storeError(handle, std::invalid_argument("Batch operand offsets decrease"));
+                }
+            }
+            if (operand_offsets[last] > 0 && !operands) {
+                return storeError(handle, std::invalid_argument("Batch operands missing"));
+            }
+        }
+        
+        BatchInput input;
+        input.count = static_cast<size_t>(count);
+        input.opcodes = opcodes;
+        input.operands = operands;
+        input.operandOffsets = operand_offsets;
+        
+        BatchOutput& batch = contextOf(handle)->batch;
+        try {
+            std::shared_ptr<ThreadPool> pool = std::atomic_load(&contextOf(handle)->pool);
+            snapshotOf(handle)->evaluateBatch(input, format != 0, batch, pool.get());
+        } catch (const std::exception& e) {
+            batch = BatchOutput();
+            return storeError(handle, e);
+        }
+        if (batch.text.size() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+            batch = BatchOutput();
+            return storeError(handle, std::length_error("Batch results longer than INT_MAX"));
+        }
+        
+        std::copy(batch.offsets.begin(), batch.offsets.end(), result_offsets);
+        std::copy(batch.status.begin(), batch.status.end(), status);
+        if (out && out_cap >= 0 && batch.text.size() <= static_cast<size_t>(out_cap)) {
+            std::memcpy(out, batch.text.data(), batch.text.size());
+        }
+        return static_cast<int>(batch.text.size());
+    }
+    
+    // Threads for batches of this handle: 0 = one per hardware thread (a pool shared
+    // by all handles), 1 = evaluate on the calling thread, n = a private pool of n.
+    // Returns 1, or 0 with the error in result slot 0 if the threads cannot be started
+    // (the handle keeps its pool then)
+    int algebra_set_batch_threads(AlgebraHandle handle, int threads) {
+        try {
+            std::shared_ptr<ThreadPool> pool;
+            if (threads <= 0) {
+                pool = std::shared_ptr<ThreadPool>(std::shared_ptr<ThreadPool>(), &ThreadPool::shared());
+            } else if (threads > 1) {
+                pool = std::make_shared<ThreadPool>(static_cast<unsigned>(threads));
+            }
+            std::atomic_store(&contextOf(handle)->pool, pool);
+            return 1;
+        } catch (const std::exception& e) {
+            storeError(handle, e);
+            return 0;
+        }
+    }
+    
+    // Copy the packed results of the last batch; returns their length (copied only if it fits)
+    int algebra_copy_batch_results(AlgebraHandle handle, char* out, int out_cap) {
+        const std::string& text = contextOf(handle)->batch.text;
+        if (out && out_cap >= 0 && text.size() <= static_cast<size_t>(out_cap)) {
+            std::memcpy(out, text.data(), text.size());
+        }
+        return static_cast<int>(text.size());
+    }
+    
+    // Render a whole table (kind: TableKind, format: TableFormat) into result.
+    // Returns the full length; the output is NUL-terminated and complete only if it is below result_size.
+    // -1 for an unknown kind or format or a failed export, with the error text in result slot 0
+    int algebra_render_table(AlgebraHandle handle, int kind, int format, char* result, int result_size) {
+        if (kind < TABLE_ADDITION || kind > TABLE_MULTIPLICATION_CARRY || format < FORMAT_TEXT || format > FORMAT_BINARY) {
+            return storeError(handle, std::invalid_argument("Unknown table kind or format"));
+        }
+        try {
+            OperationTable table = snapshotOf(handle)->exportTable(static_cast<TableKind>(kind));
+            size_t capacity = result_size > 0 ? static_cast<size_t>(result_size - 1) : 0;
+            size_t length = renderTable(table, static_cast<TableFormat>(format), result, capacity);
+            if (result_size > 0) result[length < capacity ? length : capacity] = '\0';
+            return static_cast<int>(length);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
+    }
+    
+    // Copy a whole table into a caller-provided n x n buffer in one call, row-major,
+    // cell = id(a) * n + id(b). kind 0-3: addition, multiplication, subtraction, division,
+    // each cell the id of the result element (elements[id]).
+    // Returns n * n (out is filled only if cap is at least that), or -1 for an unknown kind
+    // or a failed copy, with the error text in result slot 0
+    int algebra_export_table(AlgebraHandle handle, int kind, uint8_t* out, int cap) {
+        if (kind < TABLE_ADDITION || kind > TABLE_DIVISION) {
+            return storeError(handle, std::invalid_argument("Unknown table kind"));
+        }
+        try {
+            size_t capacity = cap > 0 ? static_cast<size_t>(cap) : 0;
+            return static_cast<int>(snapshotOf(handle)->copyTableCells(static_cast<TableKind>(kind), out, capacity));
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
+    }
+    
+    // Carry variant: kind 0 = addition, 1 = multiplication, each cell the number of carries
+    int algebra_export_carry_table(AlgebraHandle handle, int kind, uint8_t* out, int cap) {
+        if (kind < 0 || kind > 1) {
+            return storeError(handle, std::invalid_argument("Unknown carry table kind"));
+        }
+        try {
+            size_t capacity = cap > 0 ? static_cast<size_t>(cap) : 0;
+            TableKind carryKind = kind == 0 ? TABLE_ADDITION_CARRY : TABLE_MULTIPLICATION_CARRY;
+            return static_cast<int>(snapshotOf(handle)->copyTableCells(carryKind, out, capacity));
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
     }
     
     // Get element count
     int algebra_get_element_count(AlgebraHandle handle) {
-        return static_cast<Algebra*>(handle)->getElements().size();
+        return snapshotOf(handle)->getElements().size();
     }
     
     // Get element at index
     char algebra_get_element(AlgebraHandle handle, int index) {
-        const auto& elements = static_cast<Algebra*>(handle)->getElements();
+        std::shared_ptr<const Algebra> algebra = snapshotOf(handle);
+        const auto& elements = algebra->getElements();
         if (index >= 0 && index < elements.size()) {
             return elements[index];
         }
@@ -118,7 +497,8 @@ extern "C" {
     
     // Get element position
     int algebra_get_element_position(AlgebraHandle handle, char element) {
-        const auto& positions = static_cast<Algebra*>(handle)->getElementPosition();
+        std::shared_ptr<const Algebra> algebra = snapshotOf(handle);
+        const auto& positions = algebra->getElementPosition();
         auto it = positions.find(element);
         if (it != positions.end()) {
             return it->second;
@@ -126,42 +506,92 @@ extern "C" {
         return -1;
     }
     
-    // Single element operations
+    // Single element operations. Each returns '\0' if it fails (e.g. an operand that is
+    // not an element), with the error text in result slot 0
     char algebra_add_single(AlgebraHandle handle, char a, char b) {
-        return static_cast<Algebra*>(handle)->add(a, b);
+        try {
+            return snapshotOf(handle)->add(a, b);
+        } catch (const std::exception& e) {
+            storeError(handle, e);
+            return '\0';
+        }
     }
     
     char algebra_multiply_single(AlgebraHandle handle, char a, char b) {
-        return static_cast<Algebra*>(handle)->multiply(a, b);
+        try {
+            return snapshotOf(handle)->multiply(a, b);
+        } catch (const std::exception& e) {
+            storeError(handle, e);
+            return '\0';
+        }
     }
     
     char algebra_subtract_single(AlgebraHandle handle, char a, char b) {
-        return static_cast<Algebra*>(handle)->subtract(a, b);
+        try {
+            return snapshotOf(handle)->subtract(a, b);
+        } catch (const std::exception& e) {
+            storeError(handle, e);
+            return '\0';
+        }
     }
     
     char algebra_divide_single(AlgebraHandle handle, char a, char b) {
-        return static_cast<Algebra*>(handle)->divide(a, b);
+        try {
+            return snapshotOf(handle)->divide(a, b);
+        } catch (const std::exception& e) {
+            storeError(handle, e);
+            return '\0';
+        }
+    }
+    
+    char algebra_power_single(AlgebraHandle handle, char base, char exponent) {
+        try {
+            return snapshotOf(handle)->power(base, exponent);
+        } catch (const std::exception& e) {
+            storeError(handle, e);
+            return '\0';
+        }
+    }
+    
+    char algebra_gcd_single(AlgebraHandle handle, char a, char b) {
+        try {
+            return snapshotOf(handle)->gcd(a, b);
+        } catch (const std::exception& e) {
+            storeError(handle, e);
+            return '\0';
+        }
+    }
+    
+    char algebra_lcm_single(AlgebraHandle handle, char a, char b) {
+        try {
+            return snapshotOf(handle)->lcm(a, b);
+        } catch (const std::exception& e) {
+            storeError(handle, e);
+            return '\0';
+        }
     }
     
     // Get addition carry
     int algebra_get_addition_carry(AlgebraHandle handle, char a, char b) {
-        return static_cast<Algebra*>(handle)->getAdditionCarry(a, b);
+        return snapshotOf(handle)->getAdditionCarry(a, b);
     }
     
     // Get multiplication carry
     int algebra_get_multiplication_carry(AlgebraHandle handle, char a, char b) {
-        return static_cast<Algebra*>(handle)->getMultiplicationCarry(a, b);
+        return snapshotOf(handle)->getMultiplicationCarry(a, b);
     }
     
     // Get plus one rule size
     int algebra_get_plus_one_rule_size(AlgebraHandle handle) {
-        const auto& rule = static_cast<Algebra*>(handle)->getPlusOneRule();
+        std::shared_ptr<const Algebra> algebra = snapshotOf(handle);
+        const auto& rule = algebra->getPlusOneRule();
         return rule.size();
     }
     
     // Get plus one rule for a specific input index (returns number of output elements)
     int algebra_get_plus_one_rule_outputs(AlgebraHandle handle, int inputIndex, char* outputs, int maxSize) {
-        const auto& rule = static_cast<Algebra*>(handle)->getPlusOneRule();
+        std::shared_ptr<const Algebra> algebra = snapshotOf(handle);
+        const auto& rule = algebra->getPlusOneRule();
         if (inputIndex < 0 || inputIndex >= (int)rule.size()) {
             return 0;
         }
@@ -177,16 +607,22 @@ extern "C" {
     }
     
     // Get max value (for bounded mode)
-    void algebra_get_max_value(AlgebraHandle handle, char* result, int maxSize) {
-        std::string maxVal = static_cast<Algebra*>(handle)->getMaxValue();
-        strncpy(result, maxVal.c_str(), maxSize - 1);
-        result[maxSize - 1] = '\0';
+    int algebra_get_max_value(AlgebraHandle handle, char* result, int maxSize) {
+        try {
+            std::string maxVal = snapshotOf(handle)->getMaxValue();
+            return storeResult(handle, 0, maxVal, result, maxSize);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
     }
     
     // Get min value (for bounded mode)
-    void algebra_get_min_value(AlgebraHandle handle, char* result, int maxSize) {
-        std::string minVal = static_cast<Algebra*>(handle)->getMinValue();
-        strncpy(result, minVal.c_str(), maxSize - 1);
-        result[maxSize - 1] = '\0';
+    int algebra_get_min_value(AlgebraHandle handle, char* result, int maxSize) {
+        try {
+            std::string minVal = snapshotOf(handle)->getMinValue();
+            return storeResult(handle, 0, minVal, result, maxSize);
+        } catch (const std::exception& e) {
+            return storeError(handle, e);
+        }
     }
 }
@@ -0,0 +1,148 @@
+#include "algebra_cache.h"
+#include <vector>
+#include <algorithm>
+
+AlgebraCache::AlgebraCache(size_t capacity) : capacity(capacity) {}
+
+AlgebraCache& AlgebraCache::shared() {
+    static AlgebraCache cache;
+    return cache;
+}
+
+std::string AlgebraCache::normalizeRule(int bits, const std::string& rule) {
+    // Same scan as setPlusOneRule: elements are 'a'.. up to bits (at most 26)
+    char minElem = 'a';
+    char maxElem = static_cast<char>('a' + std::min(bits, 26) - 1);
+    std::vector<std::string> positions;
+
+    for (size_t i = 0; i < rule.length(); ) {
+        if (rule[i] == '{') {
+            std::string group;
+            i++;
+            while (i < rule.length() && rule[i] != '}') {
+                if (rule[i] >= minElem && rule[i] <= maxElem) {
+                    group.push_back(rule[i]);
+                }
+                i++;
+            }
+            i++;
+            positions.push_back(group);
+        } else if (rule[i] >= minElem && rule[i] <= maxElem) {
+            positions.push_back(std::string(1, rule[i]));
+            i++;
+        } else {
+            i++;
+        }
+    }
+
+    // Empty positions at the end are the same as none
+    while (!positions.empty() && positions.back().empty()) {
+        positions.pop_back();
+    }
+
+    std::string normalized;
+    for (const std::string& group : positions) {
+        if (group.size() == 1) {
+            normalized += group;
+            continue;
+        }
+        normalized += '{';
+        for (size_t k = 0; k < group.size(); k++) {
+            if (k > 0) normalized += ',';
+            normalized += group[k];
+        }
+        normalized += '}';
+    }
+    return normalized;
+}
+
+std::string AlgebraCache::keyOf(int bits, const std::string& rule) {
+    return std::to_string(bits) + ':' + normalizeRule(bits, rule);
+}
+
+std::shared_ptr<const Algebra> AlgebraCache::get(int bits, const std::string& rule) {
+    std::string key = keyOf(bits, rule);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = index.find(key);
+        if (found != index.end()) {
+            entries.splice(entries.begin(), entries, found->second);
+            return found->second->algebra;
+        }
+    }
+
+    // Compile without the lock, so other rules are served meanwhile. Two threads
+    // missing the same rule both compile it; the first one stored is kept
+    std::shared_ptr<Algebra> compiled = std::make_shared<Algebra>(bits);
+    compiled->setPlusOneRule(rule);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return store(key, compiled);
+}
+
+std::shared_ptr<const Algebra> AlgebraCache::preload(const std::string& path) {
+    std::shared_ptr<Algebra> loaded = std::make_shared<Algebra>();
+    loaded->loadImage(path);
+
+    // The key of the rule the image was compiled from
+    std::string rule;
+    for (const std::vector<char>& group : loaded->getPlusOneRule()) {
+        rule += '{';
+        rule.append(group.begin(), group.end());
+        rule += '}';
+    }
+    std::string key = keyOf(loaded->getBits(), rule);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(key);
+    if (found != index.end()) {
+        entries.erase(found->second);
+        index.erase(found);
+    }
+    return store(key, loaded);
+}
+
+std::shared_ptr<const Algebra> AlgebraCache::store(const std::string& key, std::shared_ptr<const Algebra> algebra) {
+    if (capacity == 0) {
+        return algebra;
+    }
+    auto found = index.find(key);
+    if (found != index.end()) {
+        entries.splice(entries.begin(), entries, found->second);
+        return found->second->algebra;
+    }
+    entries.push_front(Entry{key, algebra});
+    index[key] = entries.begin();
+    trim();
+    return algebra;
+}
+
+void AlgebraCache::setCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->capacity = capacity;
+    trim();
+}
+
+size_t AlgebraCache::getCapacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return capacity;
+}
+
+size_t AlgebraCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void AlgebraCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    entries.clear();
+}
+
+void AlgebraCache::trim() {
+    // Handles already given out keep their algebra alive
+    while (entries.size() > capacity) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
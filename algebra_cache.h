@@ -0,0 +1,56 @@
+#ifndef ALGEBRA_CACHE_H
+#define ALGEBRA_CACHE_H
+
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+#include "algebra.h"
+
+// Process-wide cache of compiled algebras keyed by (bits, +1 rule). Each algebra is
+// compiled once and handed out as a shared, immutable snapshot, so initializing
+// with a rule seen before is a hash lookup instead of a recompilation.
+// The least recently used algebras are dropped beyond the capacity
+class AlgebraCache {
+public:
+    explicit AlgebraCache(size_t capacity = 32);
+
+    static AlgebraCache& shared();  // The cache of the process
+
+    // Compiled algebra (bounded mode off) for bits and rule, compiled on a miss.
+    // Throws what setPlusOneRule throws; nothing is cached then
+    std::shared_ptr<const Algebra> get(int bits, const std::string& rule);
+
+    // Loads a compiled image (algebra_image.h) and keeps it under its bits and rule,
+    // so a process can start with precompiled algebras. Throws std::runtime_error
+    std::shared_ptr<const Algebra> preload(const std::string& path);
+
+    // Canonical form of rule as setPlusOneRule reads it: one element per position,
+    // "{e,c}" for a shared position, other characters dropped. Rules with the same
+    // form compile to the same algebra ("b h g {e, c}" and "bhg{ec}" give "bhg{e,c}")
+    static std::string normalizeRule(int bits, const std::string& rule);
+
+    void setCapacity(size_t capacity);  // Drops algebras beyond it; 0 disables caching
+    size_t getCapacity() const;
+    size_t size() const;
+    void clear();
+
+private:
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const Algebra> algebra;
+    };
+
+    mutable std::mutex mutex;
+    size_t capacity;
+    std::list<Entry> entries;  // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+
+    static std::string keyOf(int bits, const std::string& rule);
+    std::shared_ptr<const Algebra> store(const std::string& key, std::shared_ptr<const Algebra> algebra);  // Requires mutex
+    void trim();  // Requires mutex
+};
+
+#endif // ALGEBRA_CACHE_H
@@ -0,0 +1,257 @@
+#include "algebra_image.h"
+#include "algebra.h"
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ALGEBRA_IMAGE_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MappedImage::MappedImage(const std::string& path) {
+#ifdef ALGEBRA_IMAGE_MMAP
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open algebra image: " + path);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("Cannot open algebra image: " + path);
+    }
+    length = static_cast<size_t>(info.st_size);
+    if (length > 0) {
+        void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Cannot map algebra image: " + path);
+        }
+        bytes = static_cast<const uint8_t*>(address);
+        mapped = true;
+    }
+    close(fd);  // The mapping stays valid
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open algebra image: " + path);
+    }
+    std::vector<char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    length = contents.size();
+    uint8_t* copy = new uint8_t[length > 0 ? length : 1];
+    std::memcpy(copy, contents.data(), length);
+    bytes = copy;
+#endif
+}
+
+MappedImage::~MappedImage() {
+#ifdef ALGEBRA_IMAGE_MMAP
+    if (mapped) munmap(const_cast<uint8_t*>(bytes), length);
+#else
+    delete[] bytes;
+#endif
+}
+
+static void putU32(std::string& image, size_t at, uint32_t value) {
+    for (int k = 0; k < 4; k++) {
+        image[at + k] = static_cast<char>((value >> (8 * k)) & 0xFF);
+    }
+}
+
+static uint32_t getU32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+           static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+}
+
+std::string Algebra::serializeImage() const {
+    size_t n = elements.size();
+    if (n == 0 || positionOf.size() != n) {
+        throw std::runtime_error("No +1 rule set");
+    }
+
+    std::vector<std::string> sections(IMAGE_SECTIONS);
+    sections[IMAGE_ELEMENTS].assign(elements.begin(), elements.end());
+    for (const std::vector<char>& group : plusOneRule) {
+        sections[IMAGE_RULE_SIZES] += static_cast<char>(group.size());
+        sections[IMAGE_RULE_ELEMENTS].append(group.begin(), group.end());
+    }
+    for (size_t i = 0; i < n; i++) {
+        sections[IMAGE_POSITIONS] += static_cast<char>(positionOf[i] < 0 ? IMAGE_NONE : positionOf[i]);
+        sections[IMAGE_SUCCESSORS] += static_cast<char>(successor[i] < 0 ? IMAGE_NONE : successor[i]);
+    }
+    sections[IMAGE_POSITION_ELEMENTS].assign(positionElement.begin(), positionElement.end());
+    for (const std::string& label : positionLabel) {
+        sections[IMAGE_LABEL_SIZES] += static_cast<char>(label.size());
+        sections[IMAGE_LABELS] += label;
+    }
+    const std::vector<uint8_t>* tables[] = {
+        &additionTable, &multiplicationTable, &subtractionTable, &divisionTable,
+        &additionCarryTable, &multiplicationCarryTable, &powerTable, &gcdTable, &lcmTable
+    };
+    for (int k = 0; k < IMAGE_SECTIONS - IMAGE_ADDITION; k++) {
+        sections[IMAGE_ADDITION + k].assign(tables[k]->begin(), tables[k]->end());
+    }
+
+    std::string image(IMAGE_HEADER_SIZE + 8 * IMAGE_SECTIONS, '\0');
+    std::memcpy(&image[0], IMAGE_MAGIC, 4);
+    putU32(image, 4, IMAGE_VERSION);
+    putU32(image, 12, static_cast<uint32_t>(bits));
+    putU32(image, 16, static_cast<uint32_t>(n));
+    putU32(image, 20, static_cast<uint32_t>(cycleLength));
+    image[24] = additiveIdentity;
+    image[25] = multiplicativeIdentity;
+    putU32(image, 28, IMAGE_SECTIONS);
+    for (int s = 0; s < IMAGE_SECTIONS; s++) {
+        image.resize((image.size() + 7) & ~static_cast<size_t>(7), '\0');
+        putU32(image, IMAGE_HEADER_SIZE + 8 * s, static_cast<uint32_t>(image.size()));
+        putU32(image, IMAGE_HEADER_SIZE + 8 * s + 4, static_cast<uint32_t>(sections[s].size()));
+        image += sections[s];
+    }
+    putU32(image, 8, static_cast<uint32_t>(image.size()));
+    return image;
+}
+
+void Algebra::saveImage(const std::string& path) const {
+    std::string image = serializeImage();
+
+    // Written next to the target and renamed over it, so a process mapping the
+    // image never sees it half written
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(image.data(), static_cast<std::streamsize>(image.size()));
+        if (!file) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Cannot write algebra image: " + path);
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Cannot write algebra image: " + path);
+    }
+}
+
+void Algebra::loadImage(const uint8_t* data, size_t size) {
+    auto invalid = [](const std::string& reason) {
+        return std::runtime_error("Invalid algebra image: " + reason);
+    };
+
+    // Header and section table: fixed offsets, checked but not parsed
+    if (size < IMAGE_HEADER_SIZE + 8 * IMAGE_SECTIONS || std::memcmp(data, IMAGE_MAGIC, 4) != 0) {
+        throw invalid("not an image");
+    }
+    if (getU32(data + 4) != IMAGE_VERSION) throw invalid("unsupported version");
+    if (getU32(data + 8) != size) throw invalid("wrong size");
+    if (getU32(data + 28) != IMAGE_SECTIONS) throw invalid("wrong section count");
+
+    size_t n = getU32(data + 16);
+    int cycle = static_cast<int>(getU32(data + 20));
+    if (n == 0 || n > 26 || cycle < 1 || cycle > static_cast<int>(n)) throw invalid("wrong algebra size");
+
+    const uint8_t* section[IMAGE_SECTIONS];
+    size_t sectionSize[IMAGE_SECTIONS];
+    for (int s = 0; s < IMAGE_SECTIONS; s++) {
+        size_t offset = getU32(data + IMAGE_HEADER_SIZE + 8 * s);
+        sectionSize[s] = getU32(data + IMAGE_HEADER_SIZE + 8 * s + 4);
+        if (offset > size || sectionSize[s] > size - offset) throw invalid("section out of range");
+        section[s] = data + offset;
+    }
+
+    // Every byte that is later used as an index is checked, so a damaged
+    // image is rejected instead of read out of bounds
+    auto isElement = [n](uint8_t c) { return c >= 'a' && c < 'a' + n; };
+    if (sectionSize[IMAGE_ELEMENTS] != n || sectionSize[IMAGE_POSITIONS] != n ||
+        sectionSize[IMAGE_SUCCESSORS] != n || sectionSize[IMAGE_RULE_SIZES] > n ||
+        sectionSize[IMAGE_POSITION_ELEMENTS] != static_cast<size_t>(cycle) ||
+        sectionSize[IMAGE_LABEL_SIZES] != static_cast<size_t>(cycle)) {
+        throw invalid("wrong section size");
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (section[IMAGE_ELEMENTS][i] != 'a' + i) throw invalid("wrong elements");
+        uint8_t pos = section[IMAGE_POSITIONS][i];
+        uint8_t next = section[IMAGE_SUCCESSORS][i];
+        if ((pos != IMAGE_NONE && pos >= cycle) || (next != IMAGE_NONE && next >= n)) throw invalid("wrong position");
+    }
+    if (data[24] < 'a' || data[24] > 'z' || data[25] < 'a' || data[25] > 'z') throw invalid("wrong identities");
+
+    size_t ruleElements = 0;
+    for (size_t p = 0; p < sectionSize[IMAGE_RULE_SIZES]; p++) {
+        ruleElements += section[IMAGE_RULE_SIZES][p];
+    }
+    if (ruleElements != sectionSize[IMAGE_RULE_ELEMENTS]) throw invalid("wrong rule");
+    for (size_t i = 0; i < ruleElements; i++) {
+        if (!isElement(section[IMAGE_RULE_ELEMENTS][i])) throw invalid("wrong rule");
+    }
+
+    size_t labelChars = 0;
+    for (int p = 0; p < cycle; p++) {
+        if (!isElement(section[IMAGE_POSITION_ELEMENTS][p])) throw invalid("wrong position element");
+        labelChars += section[IMAGE_LABEL_SIZES][p];
+    }
+    if (labelChars != sectionSize[IMAGE_LABELS]) throw invalid("wrong labels");
+
+    for (int s = IMAGE_ADDITION; s < IMAGE_SECTIONS; s++) {
+        if (sectionSize[s] != 0 && sectionSize[s] != n * n) throw invalid("wrong table size");
+        bool carries = s == IMAGE_ADDITION_CARRY || s == IMAGE_MULTIPLICATION_CARRY;
+        for (size_t cell = 0; !carries && cell < sectionSize[s]; cell++) {
+            if (section[s][cell] >= n) throw invalid("wrong table cell");
+        }
+    }
+
+    // Valid: replace the compiled algebra
+    bits = static_cast<int>(getU32(data + 12));
+    elements.assign(section[IMAGE_ELEMENTS], section[IMAGE_ELEMENTS] + n);
+    additiveIdentity = static_cast<char>(data[24]);
+    multiplicativeIdentity = static_cast<char>(data[25]);
+
+    plusOneRule.assign(std::max(sectionSize[IMAGE_RULE_SIZES], n), std::vector<char>());
+    const uint8_t* ruleElement = section[IMAGE_RULE_ELEMENTS];
+    for (size_t p = 0; p < sectionSize[IMAGE_RULE_SIZES]; p++) {
+        plusOneRule[p].assign(ruleElement, ruleElement + section[IMAGE_RULE_SIZES][p]);
+        ruleElement += section[IMAGE_RULE_SIZES][p];
+    }
+
+    elementPosition.clear();
+    positionOf.assign(n, -1);
+    successor.assign(n, -1);
+    for (size_t i = 0; i < n; i++) {
+        uint8_t pos = section[IMAGE_POSITIONS][i];
+        uint8_t next = section[IMAGE_SUCCESSORS][i];
+        if (pos != IMAGE_NONE) {
+            positionOf[i] = pos;
+            elementPosition[elements[i]] = pos;
+        }
+        if (next != IMAGE_NONE) successor[i] = next;
+    }
+
+    cycleLength = cycle;
+    positionElement.assign(section[IMAGE_POSITION_ELEMENTS], section[IMAGE_POSITION_ELEMENTS] + cycle);
+    positionLabel.assign(cycle, std::string());
+    const uint8_t* label = section[IMAGE_LABELS];
+    for (int p = 0; p < cycle; p++) {
+        positionLabel[p].assign(label, label + section[IMAGE_LABEL_SIZES][p]);
+        label += section[IMAGE_LABEL_SIZES][p];
+    }
+
+    std::vector<uint8_t>* tables[] = {
+        &additionTable, &multiplicationTable, &subtractionTable, &divisionTable,
+        &additionCarryTable, &multiplicationCarryTable, &powerTable, &gcdTable, &lcmTable
+    };
+    for (int k = 0; k < IMAGE_SECTIONS - IMAGE_ADDITION; k++) {
+        tables[k]->assign(section[IMAGE_ADDITION + k], section[IMAGE_ADDITION + k] + sectionSize[IMAGE_ADDITION + k]);
+    }
+
+    radix = RadixConverter(cycleLength);
+}
+
+void Algebra::loadImage(const std::string& path) {
+    MappedImage image(path);
+    loadImage(image.data(), image.size());
+}
@@ -0,0 +1,64 @@
+#ifndef ALGEBRA_IMAGE_H
+#define ALGEBRA_IMAGE_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+// Compiled algebra images: everything setPlusOneRule compiles (elements, rule,
+// positions, position labels, operation and carry tables) in a versioned binary
+// file that Algebra::loadImage maps and copies back without recompiling.
+//
+// Layout (integers are little-endian uint32, offsets are from the start of the
+// file, so an image can be mapped at any address):
+//   "ALGB", version, file size, bits, elements n, cycle length,
+//   additive identity, multiplicative identity, 0, 0 (bytes), section count,
+//   then {offset, size} for each ImageSection; sections start 8-byte aligned
+// Bytes of the position and successor sections are 0xFF where there is none;
+// tables are n * n cells like the compiled ones, or empty if not compiled
+
+const char IMAGE_MAGIC[4] = {'A', 'L', 'G', 'B'};
+const uint32_t IMAGE_VERSION = 1;
+const size_t IMAGE_HEADER_SIZE = 32;  // Before the section table
+const uint8_t IMAGE_NONE = 0xFF;
+
+enum ImageSection {
+    IMAGE_ELEMENTS = 0,           // n element characters
+    IMAGE_RULE_SIZES = 1,         // Elements at each position of the +1 rule
+    IMAGE_RULE_ELEMENTS = 2,      // Those elements, position after position
+    IMAGE_POSITIONS = 3,          // Element id -> position in the cycle
+    IMAGE_SUCCESSORS = 4,         // Element id -> id of its +1 representative
+    IMAGE_POSITION_ELEMENTS = 5,  // Position -> representative element
+    IMAGE_LABEL_SIZES = 6,        // Position -> length of its display label
+    IMAGE_LABELS = 7,             // The labels, position after position
+    IMAGE_ADDITION = 8,
+    IMAGE_MULTIPLICATION = 9,
+    IMAGE_SUBTRACTION = 10,
+    IMAGE_DIVISION = 11,
+    IMAGE_ADDITION_CARRY = 12,
+    IMAGE_MULTIPLICATION_CARRY = 13,
+    IMAGE_POWER = 14,
+    IMAGE_GCD = 15,
+    IMAGE_LCM = 16,
+    IMAGE_SECTIONS = 17
+};
+
+// A file mapped read-only (read into memory where mmap is not available).
+// Many processes mapping the same image share its pages through the page cache
+class MappedImage {
+public:
+    explicit MappedImage(const std::string& path);  // Throws std::runtime_error if it cannot be read
+    ~MappedImage();
+    MappedImage(const MappedImage&) = delete;
+    MappedImage& operator=(const MappedImage&) = delete;
+
+    const uint8_t* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const uint8_t* bytes = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+};
+
+#endif // ALGEBRA_IMAGE_H
@@ -0,0 +1,48 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Operations of a batch. The values are part of the C API
+// (algebra_c_wrapper.cpp), so they must not be reordered
+enum BatchOpcode {
+    BATCH_ADD = 0,          // a + b
+    BATCH_SUBTRACT = 1,     // a - b
+    BATCH_MULTIPLY = 2,     // a * b
+    BATCH_DIVIDE = 3,       // Quotient of a / b
+    BATCH_REMAINDER = 4,    // Remainder of a / b (as returned by divideArithmetic)
+    BATCH_MOD = 5,          // a mod b
+    BATCH_POWER = 6,        // a ^ b
+    BATCH_POWMOD = 7,       // (a ^ b) mod c
+    BATCH_GCD = 8,
+    BATCH_LCM = 9,
+    BATCH_MOD_INVERSE = 10  // Inverse of a modulo b
+};
+
+enum BatchStatus {
+    BATCH_OK = 0,
+    BATCH_ERROR = 1  // The result holds the error message
+};
+
+const int BATCH_OPERANDS = 3;  // Operand slots per operation (a, b, c), unused ones are empty
+
+// Packed batch of count operations: operation i is opcodes[i] applied to the
+// operands k = 0..2 stored at operands[operandOffsets[3 * i + k], operandOffsets[3 * i + k + 1])
+struct BatchInput {
+    size_t count = 0;
+    const uint8_t* opcodes = nullptr;
+    const char* operands = nullptr;
+    const uint32_t* operandOffsets = nullptr;  // 3 * count + 1 entries
+};
+
+// Results back to back in one buffer
+struct BatchOutput {
+    std::string text;
+    std::vector<uint32_t> offsets;  // count + 1 entries: result i is text[offsets[i], offsets[i + 1])
+    std::vector<uint8_t> status;    // BatchStatus of each operation
+};
+
+#endif // BATCH_H
@@ -0,0 +1,213 @@
+#include "element_kernels.h"
+#include <atomic>
+#include <cstring>
+
+// The vector kernels need GCC/Clang target attributes; other compilers and
+// architectures get the scalar kernel only
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ELEMENT_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+static std::atomic<int> kernelLimit(KERNEL_AVX512);
+
+KernelIsa detectKernelIsa() {
+#ifdef ELEMENT_KERNELS_X86
+    static const KernelIsa detected = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vbmi")) return KERNEL_AVX512;
+        if (__builtin_cpu_supports("avx2")) return KERNEL_AVX2;
+        if (__builtin_cpu_supports("ssse3")) return KERNEL_SSSE3;
+        return KERNEL_SCALAR;
+    }();
+    return detected;
+#else
+    return KERNEL_SCALAR;
+#endif
+}
+
+KernelIsa getKernelIsa() {
+    int limit = kernelLimit.load(std::memory_order_relaxed);
+    int detected = detectKernelIsa();
+    return static_cast<KernelIsa>(limit < detected ? limit : detected);
+}
+
+KernelIsa setKernelIsa(KernelIsa isa) {
+    kernelLimit.store(isa < KERNEL_SCALAR ? KERNEL_SCALAR : isa, std::memory_order_relaxed);
+    return getKernelIsa();
+}
+
+const char* kernelIsaName(KernelIsa isa) {
+    switch (isa) {
+        case KERNEL_SCALAR: return "scalar";
+        case KERNEL_SSSE3: return "ssse3";
+        case KERNEL_AVX2: return "avx2";
+        case KERNEL_AVX512: return "avx512";
+    }
+    return "";
+}
+
+void prepareKernelTable(const uint8_t* cells, size_t n, const char* elements, KernelTable& table) {
+    table.n = n;
+    table.first = n > 0 ? elements[0] : 'a';
+    std::memset(table.rows, 0, sizeof(table.rows));
+    for (size_t row = 0; row < n; row++) {
+        for (size_t col = 0; col < n; col++) {
+            uint8_t cell = cells[row * n + col];
+            table.rows[row * KERNEL_ROW + col] = cell < n ? elements[cell] : '\0';
+        }
+    }
+}
+
+// Element id of c, out of range (>= n) if c is not an element
+static inline uint8_t kernelId(char c, char first) {
+    return static_cast<uint8_t>(static_cast<uint8_t>(c) - static_cast<uint8_t>(first));
+}
+
+static bool lookupScalar(const KernelTable& table, const char* a, const char* b, char* out, size_t count) {
+    bool valid = true;
+    for (size_t i = 0; i < count; i++) {
+        uint8_t idA = kernelId(a[i], table.first);
+        uint8_t idB = kernelId(b[i], table.first);
+        if (idA < table.n && idB < table.n) {
+            out[i] = table.rows[idA * KERNEL_ROW + idB];
+        } else {
+            out[i] = '\0';
+            valid = false;
+        }
+    }
+    return valid;
+}
+
+#ifdef ELEMENT_KERNELS_X86
+
+// SSSE3/AVX2: for every row r, shuffle the row by id(b) and keep the lanes
+// with id(a) == r. Ids 16..31 take the second half of the row
+__attribute__((target("ssse3")))
+static bool lookupSsse3(const KernelTable& table, const char* a, const char* b, char* out, size_t count) {
+    const __m128i first = _mm_set1_epi8(table.first);
+    const __m128i last = _mm_set1_epi8(static_cast<char>(table.n - 1));
+    const __m128i fifteen = _mm_set1_epi8(15);
+    const bool wide = table.n > 16;
+    int invalid = 0;
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i idA = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), first);
+        __m128i idB = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)), first);
+        __m128i valid = _mm_and_si128(_mm_cmpeq_epi8(_mm_min_epu8(idA, last), idA),
+                                      _mm_cmpeq_epi8(_mm_min_epu8(idB, last), idB));
+        __m128i high = _mm_cmpgt_epi8(idB, fifteen);
+
+        __m128i result = _mm_setzero_si128();
+        for (size_t r = 0; r < table.n; r++) {
+            const __m128i* row = reinterpret_cast<const __m128i*>(table.rows + r * KERNEL_ROW);
+            __m128i value = _mm_shuffle_epi8(_mm_load_si128(row), idB);
+            if (wide) {
+                __m128i upper = _mm_shuffle_epi8(_mm_load_si128(row + 1), idB);
+                value = _mm_or_si128(_mm_andnot_si128(high, value), _mm_and_si128(high, upper));
+            }
+            __m128i match = _mm_cmpeq_epi8(idA, _mm_set1_epi8(static_cast<char>(r)));
+            result = _mm_or_si128(result, _mm_and_si128(match, value));
+        }
+
+        invalid |= _mm_movemask_epi8(valid) ^ 0xFFFF;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_and_si128(result, valid));
+    }
+
+    bool tailValid = lookupScalar(table, a + i, b + i, out + i, count - i);
+    return invalid == 0 && tailValid;
+}
+
+__attribute__((target("avx2")))
+static bool lookupAvx2(const KernelTable& table, const char* a, const char* b, char* out, size_t count) {
+    const __m256i first = _mm256_set1_epi8(table.first);
+    const __m256i last = _mm256_set1_epi8(static_cast<char>(table.n - 1));
+    const __m256i fifteen = _mm256_set1_epi8(15);
+    const bool wide = table.n > 16;
+    unsigned invalid = 0;
+
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i idA = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), first);
+        __m256i idB = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)), first);
+        __m256i valid = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(idA, last), idA),
+                                         _mm256_cmpeq_epi8(_mm256_min_epu8(idB, last), idB));
+        __m256i high = _mm256_cmpgt_epi8(idB, fifteen);
+
+        // vpshufb shuffles within 128-bit lanes, so each half row is broadcast to both
+        __m256i result = _mm256_setzero_si256();
+        for (size_t r = 0; r < table.n; r++) {
+            const __m128i* row = reinterpret_cast<const __m128i*>(table.rows + r * KERNEL_ROW);
+            __m256i value = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_load_si128(row)), idB);
+            if (wide) {
+                __m256i upper = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_load_si128(row + 1)), idB);
+                value = _mm256_blendv_epi8(value, upper, high);
+            }
+            __m256i match = _mm256_cmpeq_epi8(idA, _mm256_set1_epi8(static_cast<char>(r)));
+            result = _mm256_blendv_epi8(result, value, match);
+        }
+
+        invalid |= ~static_cast<unsigned>(_mm256_movemask_epi8(valid));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_and_si256(result, valid));
+    }
+
+    bool tailValid = lookupScalar(table, a + i, b + i, out + i, count - i);
+    return invalid == 0 && tailValid;
+}
+
+// AVX-512 VBMI: vpermi2b looks up 128 bytes, i.e. four rows at once, with the
+// index id(b) + 32 * (id(a) & 3); rows are then selected by id(a) >> 2.
+// The tail is handled with masked loads and stores
+__attribute__((target("avx512f,avx512bw,avx512vbmi")))
+static bool lookupAvx512(const KernelTable& table, const char* a, const char* b, char* out, size_t count) {
+    const __m512i first = _mm512_set1_epi8(table.first);
+    const __m512i last = _mm512_set1_epi8(static_cast<char>(table.n - 1));
+    const __m512i three = _mm512_set1_epi8(3);
+    const __m512i groupBits = _mm512_set1_epi8(0x3F);
+    const size_t groups = (table.n + 3) / 4;
+    __mmask64 invalid = 0;
+
+    for (size_t i = 0; i < count; i += 64) {
+        __mmask64 lanes = count - i >= 64 ? ~static_cast<__mmask64>(0) : (static_cast<__mmask64>(1) << (count - i)) - 1;
+        __m512i idA = _mm512_sub_epi8(_mm512_maskz_loadu_epi8(lanes, a + i), first);
+        __m512i idB = _mm512_sub_epi8(_mm512_maskz_loadu_epi8(lanes, b + i), first);
+        __mmask64 valid = _mm512_cmple_epu8_mask(idA, last) & _mm512_cmple_epu8_mask(idB, last) & lanes;
+
+        __m512i index = _mm512_or_si512(idB, _mm512_slli_epi16(_mm512_and_si512(idA, three), 5));
+        __m512i group = _mm512_and_si512(_mm512_srli_epi16(idA, 2), groupBits);
+
+        __m512i result = _mm512_setzero_si512();
+        for (size_t g = 0; g < groups; g++) {
+            const char* rows = table.rows + g * 4 * KERNEL_ROW;
+            __m512i value = _mm512_permutex2var_epi8(_mm512_load_si512(rows), index, _mm512_load_si512(rows + 64));
+            __mmask64 match = _mm512_cmpeq_epi8_mask(group, _mm512_set1_epi8(static_cast<char>(g)));
+            result = _mm512_mask_mov_epi8(result, match, value);
+        }
+
+        invalid |= ~valid & lanes;
+        _mm512_mask_storeu_epi8(out + i, lanes, _mm512_maskz_mov_epi8(valid, result));
+    }
+    return invalid == 0;
+}
+
+#endif // ELEMENT_KERNELS_X86
+
+bool lookupElements(const KernelTable& table, const char* a, const char* b, char* out, size_t count) {
+    return lookupElements(table, a, b, out, count, getKernelIsa());
+}
+
+bool lookupElements(const KernelTable& table, const char* a, const char* b, char* out, size_t count, KernelIsa isa) {
+    if (isa > detectKernelIsa()) isa = detectKernelIsa();
+    // Tables over 16 elements take two shuffles per row; at 16 lanes that loses to scalar
+    if (isa == KERNEL_SSSE3 && table.n > 16) isa = KERNEL_SCALAR;
+#ifdef ELEMENT_KERNELS_X86
+    switch (isa) {
+        case KERNEL_AVX512: return lookupAvx512(table, a, b, out, count);
+        case KERNEL_AVX2: return lookupAvx2(table, a, b, out, count);
+        case KERNEL_SSSE3: return lookupSsse3(table, a, b, out, count);
+        case KERNEL_SCALAR: break;
+    }
+#endif
+    return lookupScalar(table, a, b, out, count);
+}
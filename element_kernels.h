@@ -0,0 +1,42 @@
+#ifndef ELEMENT_KERNELS_H
+#define ELEMENT_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Element-wise single-digit operations over arrays of elements:
+// out[i] = a[i] op b[i] by table lookup, vectorized with byte shuffles
+// (pshufb, or vpermi2b on AVX-512) on x86 and picked at runtime
+
+// Instruction sets of the kernels, in increasing order
+enum KernelIsa {
+    KERNEL_SCALAR = 0,
+    KERNEL_SSSE3 = 1,   // 16 elements per step, pshufb
+    KERNEL_AVX2 = 2,    // 32 elements per step, vpshufb
+    KERNEL_AVX512 = 3   // 64 elements per step, vpermi2b (AVX-512 VBMI)
+};
+
+KernelIsa detectKernelIsa();       // Best instruction set this CPU and build support
+KernelIsa getKernelIsa();          // Instruction set in use (detected unless lowered)
+KernelIsa setKernelIsa(KernelIsa isa);  // Use at most isa (e.g. to compare kernels); returns the one in use
+const char* kernelIsaName(KernelIsa isa);
+
+const size_t KERNEL_MAX_ELEMENTS = 32;  // A table row fits two 16-byte shuffles
+const size_t KERNEL_ROW = 32;
+
+// A compiled n x n table (cell = id(a) * n + id(b), elements first, first + 1, ...)
+// laid out for the kernels: row id(a) holds the result characters, padded to 32 bytes
+struct KernelTable {
+    size_t n = 0;
+    char first = 'a';
+    alignas(64) char rows[KERNEL_MAX_ELEMENTS * KERNEL_ROW];
+};
+
+void prepareKernelTable(const uint8_t* cells, size_t n, const char* elements, KernelTable& table);  // Requires n <= KERNEL_MAX_ELEMENTS
+
+// out[i] = table[a[i]][b[i]] for i < count. Lanes with an operand that is not an
+// element of the table get '\0'; returns true if there were none
+bool lookupElements(const KernelTable& table, const char* a, const char* b, char* out, size_t count);
+bool lookupElements(const KernelTable& table, const char* a, const char* b, char* out, size_t count, KernelIsa isa);
+
+#endif // ELEMENT_KERNELS_H
@@ -0,0 +1,514 @@
+#include "limbs.h"
+#include <utility>
+
+// Operands shorter than this (in limbs) are multiplied by schoolbook
+static const size_t KARATSUBA_LIMBS = 32;
+
+// Divisors at least this long (in limbs) are divided through a Newton reciprocal
+static const size_t NEWTON_LIMBS = 64;
+
+static void trimLimbs(Limbs& a) {
+    while (!a.empty() && a.back() == 0) {
+        a.pop_back();
+    }
+}
+
+int compareLimbs(const Limbs& a, const Limbs& b) {
+    if (a.size() > b.size()) return 1;
+    if (a.size() < b.size()) return -1;
+
+    for (size_t i = a.size(); i-- > 0; ) {
+        if (a[i] > b[i]) return 1;
+        if (a[i] < b[i]) return -1;
+    }
+    return 0;
+}
+
+Limbs addLimbs(const Limbs& a, const Limbs& b) {
+    const Limbs& longer = a.size() >= b.size() ? a : b;
+    const Limbs& shorter = a.size() >= b.size() ? b : a;
+
+    Limbs result(longer.size() + 1);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < longer.size(); i++) {
+        uint64_t sum = static_cast<uint64_t>(longer[i]) + carry;
+        if (i < shorter.size()) sum += shorter[i];
+        result[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    result[longer.size()] = static_cast<uint32_t>(carry);
+    trimLimbs(result);
+    return result;
+}
+
+Limbs subtractLimbs(const Limbs& a, const Limbs& b) {
+    Limbs result(a.size());
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        int64_t diff = static_cast<int64_t>(a[i]) - borrow;
+        if (i < b.size()) diff -= b[i];
+        borrow = diff < 0 ? 1 : 0;
+        result[i] = static_cast<uint32_t>(diff + (borrow << 32));
+    }
+    trimLimbs(result);
+    return result;
+}
+
+// a * B^count
+static Limbs shiftUp(const Limbs& a, size_t count) {
+    if (a.empty()) return a;
+    Limbs result(count, 0);
+    result.insert(result.end(), a.begin(), a.end());
+    return result;
+}
+
+// floor(a / B^count)
+static Limbs shiftDown(const Limbs& a, size_t count) {
+    if (count >= a.size()) return Limbs();
+    return Limbs(a.begin() + count, a.end());
+}
+
+// Limbs [from, to) of a as a trimmed number
+static Limbs sliceLimbs(const Limbs& a, size_t from, size_t to) {
+    if (to > a.size()) to = a.size();
+    if (from >= to) return Limbs();
+    Limbs result(a.begin() + from, a.begin() + to);
+    trimLimbs(result);
+    return result;
+}
+
+// acc += x * B^shift; acc must be long enough to hold the sum
+static void addShiftedLimbs(Limbs& acc, const Limbs& x, size_t shift) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < x.size() || carry > 0; i++) {
+        uint64_t sum = static_cast<uint64_t>(acc[shift + i]) + carry;
+        if (i < x.size()) sum += x[i];
+        acc[shift + i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+}
+
+static Limbs multiplyBySmall(const Limbs& a, uint32_t k) {
+    Limbs result(a.size() + 1);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        uint64_t cell = static_cast<uint64_t>(a[i]) * k + carry;
+        result[i] = static_cast<uint32_t>(cell);
+        carry = cell >> 32;
+    }
+    result[a.size()] = static_cast<uint32_t>(carry);
+    trimLimbs(result);
+    return result;
+}
+
+// Short division by a single limb, returns the remainder
+static uint32_t divideBySmall(const Limbs& a, uint32_t divisor, Limbs& quotient) {
+    quotient.assign(a.size(), 0);
+    uint64_t rem = 0;
+    for (size_t i = a.size(); i-- > 0; ) {
+        uint64_t cur = (rem << 32) | a[i];
+        quotient[i] = static_cast<uint32_t>(cur / divisor);
+        rem = cur % divisor;
+    }
+    trimLimbs(quotient);
+    return static_cast<uint32_t>(rem);
+}
+
+static Limbs schoolbookMultiplyLimbs(const Limbs& a, const Limbs& b) {
+    Limbs result(a.size() + b.size(), 0);
+    for (size_t j = 0; j < b.size(); j++) {
+        uint64_t limbB = b[j];
+        if (limbB == 0) continue;
+
+        // (2^32 - 1)^2 + 2 * (2^32 - 1) = 2^64 - 1, so a cell never overflows
+        uint64_t carry = 0;
+        for (size_t i = 0; i < a.size(); i++) {
+            uint64_t cell = a[i] * limbB + result[i + j] + carry;
+            result[i + j] = static_cast<uint32_t>(cell);
+            carry = cell >> 32;
+        }
+        result[j + a.size()] = static_cast<uint32_t>(carry);
+    }
+    trimLimbs(result);
+    return result;
+}
+
+Limbs multiplyLimbs(const Limbs& a, const Limbs& b) {
+    if (a.empty() || b.empty()) return Limbs();
+
+    const Limbs& longer = a.size() >= b.size() ? a : b;
+    const Limbs& shorter = a.size() >= b.size() ? b : a;
+    size_t n = longer.size();
+    size_t s = shorter.size();
+    if (s < KARATSUBA_LIMBS) return schoolbookMultiplyLimbs(longer, shorter);
+
+    Limbs acc(n + s, 0);
+
+    // Unbalanced operands: multiply the shorter one by chunks of its own length
+    if (n >= 2 * s) {
+        for (size_t from = 0; from < n; from += s) {
+            addShiftedLimbs(acc, multiplyLimbs(sliceLimbs(longer, from, from + s), shorter), from);
+        }
+        trimLimbs(acc);
+        return acc;
+    }
+
+    // Karatsuba, same split as multiplyMagnitude
+    size_t m = n / 2;
+    Limbs a0 = sliceLimbs(longer, 0, m);
+    Limbs a1 = sliceLimbs(longer, m, n);
+    Limbs b0 = sliceLimbs(shorter, 0, m);
+    Limbs b1 = sliceLimbs(shorter, m, s);
+
+    Limbs z0 = multiplyLimbs(a0, b0);
+    Limbs z2 = multiplyLimbs(a1, b1);
+    Limbs z1 = multiplyLimbs(addLimbs(a0, a1), addLimbs(b0, b1));
+    z1 = subtractLimbs(subtractLimbs(z1, z0), z2);
+
+    addShiftedLimbs(acc, z0, 0);
+    addShiftedLimbs(acc, z1, m);
+    addShiftedLimbs(acc, z2, 2 * m);
+    trimLimbs(acc);
+    return acc;
+}
+
+static int leadingZeros(uint32_t x) {
+    int count = 0;
+    while ((x & 0x80000000u) == 0) {
+        x <<= 1;
+        count++;
+    }
+    return count;
+}
+
+// Long division in base 2^32 (Knuth, TAOCP vol. 2, 4.3.1, algorithm D)
+static Limbs schoolbookDivideLimbs(const Limbs& a, const Limbs& b, Limbs& remainder) {
+    if (compareLimbs(a, b) < 0) {
+        remainder = a;
+        return Limbs();
+    }
+
+    size_t n = b.size();
+    size_t m = a.size() - n;
+    Limbs q;
+    if (n == 1) {
+        remainder.clear();
+        uint32_t rem = divideBySmall(a, b[0], q);
+        if (rem != 0) remainder.push_back(rem);
+        return q;
+    }
+
+    // D1: shift so the top bit of the divisor is set
+    int s = leadingZeros(b[n - 1]);
+    Limbs v(n);
+    Limbs u(a.size() + 1);
+    for (size_t i = n; i-- > 1; ) {
+        v[i] = s == 0 ? b[i] : (b[i] << s) | (b[i - 1] >> (32 - s));
+    }
+    v[0] = b[0] << s;
+    u[a.size()] = s == 0 ? 0 : a[a.size() - 1] >> (32 - s);
+    for (size_t i = a.size(); i-- > 1; ) {
+        u[i] = s == 0 ? a[i] : (a[i] << s) | (a[i - 1] >> (32 - s));
+    }
+    u[0] = a[0] << s;
+
+    const uint64_t B = static_cast<uint64_t>(1) << 32;
+    q.assign(m + 1, 0);
+    for (size_t j = m + 1; j-- > 0; ) {
+        // D3: estimate the quotient limb from the leading limbs
+        uint64_t top = (static_cast<uint64_t>(u[j + n]) << 32) | u[j + n - 1];
+        uint64_t qhat = top / v[n - 1];
+        uint64_t rhat = top % v[n - 1];
+        while (qhat >= B || qhat * v[n - 2] > ((rhat << 32) | u[j + n - 2])) {
+            qhat--;
+            rhat += v[n - 1];
+            if (rhat >= B) break;
+        }
+
+        // D4: multiply and subtract qhat * v from the current window
+        int64_t borrow = 0;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t product = qhat * v[i];
+            int64_t t = static_cast<int64_t>(u[i + j]) - borrow - static_cast<int64_t>(product & 0xFFFFFFFFu);
+            u[i + j] = static_cast<uint32_t>(t);
+            borrow = static_cast<int64_t>(product >> 32) - (t >> 32);
+        }
+        int64_t t = static_cast<int64_t>(u[j + n]) - borrow;
+        u[j + n] = static_cast<uint32_t>(t);
+
+        // D6: the estimate was one too large, add the divisor back
+        if (t < 0) {
+            qhat--;
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; i++) {
+                uint64_t sum = static_cast<uint64_t>(u[i + j]) + v[i] + carry;
+                u[i + j] = static_cast<uint32_t>(sum);
+                carry = sum >> 32;
+            }
+            u[j + n] = static_cast<uint32_t>(u[j + n] + carry);
+        }
+        q[j] = static_cast<uint32_t>(qhat);
+    }
+
+    // D8: unnormalize the remainder
+    remainder.assign(n, 0);
+    for (size_t i = 0; i < n; i++) {
+        remainder[i] = s == 0 ? u[i] : (u[i] >> s) | (u[i + 1] << (32 - s));
+    }
+    trimLimbs(remainder);
+    trimLimbs(q);
+    return q;
+}
+
+// About B^(2p) / d for a divisor of p limbs, at most a few units off. The top
+// half of the limbs gives a reciprocal of half the precision; one Newton step
+// x + x (1 - d x) doubles it
+static Limbs newtonReciprocal(const Limbs& d) {
+    size_t p = d.size();
+    Limbs scale = shiftUp(Limbs(1, 1), 2 * p);  // B^(2p)
+    if (p < NEWTON_LIMBS) {
+        Limbs remainder;
+        return schoolbookDivideLimbs(scale, d, remainder);
+    }
+
+    // Two extra limbs keep the error after the Newton step within a few units
+    size_t h = p / 2 + 2;
+    Limbs top(d.end() - h, d.end());
+    Limbs x = shiftUp(newtonReciprocal(top), p - h);
+
+    Limbs dx = multiplyLimbs(d, x);
+    if (compareLimbs(dx, scale) <= 0) {
+        Limbs error = subtractLimbs(scale, dx);
+        return addLimbs(x, shiftDown(multiplyLimbs(x, error), 2 * p));
+    }
+    Limbs error = subtractLimbs(dx, scale);
+    Limbs step = addLimbs(shiftDown(multiplyLimbs(x, error), 2 * p), Limbs(1, 1));
+    return compareLimbs(x, step) > 0 ? subtractLimbs(x, step) : Limbs();
+}
+
+// Reciprocal of b brought to p limbs: b is truncated to its top p limbs or
+// shifted up to p limbs, so (a * inverse) >> (p + n) estimates a / b
+static Limbs scaledReciprocal(const Limbs& b, size_t p) {
+    size_t n = b.size();
+    return newtonReciprocal(p > n ? shiftUp(b, p - n) : shiftDown(b, n - p));
+}
+
+// Quotient from a reciprocal of precision p >= k + 2 (k quotient limbs), then
+// corrected against the exact operands
+static Limbs divideByInverse(const Limbs& a, const Limbs& b, const Limbs& inverse, size_t p, Limbs& remainder) {
+    size_t n = b.size();
+
+    // Only the top p + 1 limbs of the dividend affect the estimate
+    size_t drop = a.size() > p + 1 ? a.size() - p - 1 : 0;
+    Limbs q = shiftDown(multiplyLimbs(shiftDown(a, drop), inverse), p + n - drop);
+
+    const Limbs one(1, 1);
+    Limbs product = multiplyLimbs(q, b);
+    while (compareLimbs(product, a) > 0) {
+        q = subtractLimbs(q, one);
+        product = subtractLimbs(product, b);
+    }
+    remainder = subtractLimbs(a, product);
+    while (compareLimbs(remainder, b) >= 0) {
+        q = addLimbs(q, one);
+        remainder = subtractLimbs(remainder, b);
+    }
+    return q;
+}
+
+Limbs divideLimbs(const Limbs& a, const Limbs& b, Limbs& remainder) {
+    if (compareLimbs(a, b) < 0) {
+        remainder = a;
+        return Limbs();
+    }
+
+    size_t n = b.size();
+    size_t k = a.size() - n + 1;  // Quotient limbs, at most
+    if (n < NEWTON_LIMBS || k < NEWTON_LIMBS) {
+        return schoolbookDivideLimbs(a, b, remainder);
+    }
+    return divideByInverse(a, b, scaledReciprocal(b, k + 2), k + 2, remainder);
+}
+
+Limbs reciprocalLimbs(const Limbs& b) {
+    // Precision n + 3 covers quotients of up to n + 1 limbs
+    if (b.size() < NEWTON_LIMBS) return Limbs();
+    return scaledReciprocal(b, b.size() + 3);
+}
+
+Limbs divideLimbs(const Limbs& a, const Limbs& b, const Limbs& inverse, Limbs& remainder) {
+    if (inverse.empty() || a.size() > 2 * b.size()) return divideLimbs(a, b, remainder);
+    if (compareLimbs(a, b) < 0) {
+        remainder = a;
+        return Limbs();
+    }
+    return divideByInverse(a, b, inverse, b.size() + 3, remainder);
+}
+
+Limbs gcdLimbs(const Limbs& a, const Limbs& b) {
+    // Euclid; every step is a base 2^32 long division
+    Limbs u = a;
+    Limbs v = b;
+    while (!v.empty()) {
+        Limbs remainder;
+        divideLimbs(u, v, remainder);
+        u = std::move(v);
+        v = std::move(remainder);
+    }
+    return u;
+}
+
+Limbs powerModLimbs(const Limbs& value, const Limbs& exponent, const Limbs& modulus) {
+    // Left to right square and multiply, reduced after every product
+    Limbs remainder;
+    Limbs result;
+    divideLimbs(Limbs(1, 1), modulus, result);  // 1 mod m
+    Limbs x;
+    divideLimbs(value, modulus, x);
+
+    for (size_t i = exponent.size(); i-- > 0; ) {
+        for (int bit = 31; bit >= 0; bit--) {
+            divideLimbs(multiplyLimbs(result, result), modulus, remainder);
+            result = std::move(remainder);
+            if ((exponent[i] >> bit) & 1) {
+                divideLimbs(multiplyLimbs(result, x), modulus, remainder);
+                result = std::move(remainder);
+            }
+        }
+    }
+    return result;
+}
+
+RadixConverter::RadixConverter(int base) : base(base < 2 ? 2 : base), chunkDigits(0), chunkPower(1) {
+    // Largest power of the base that still fits one limb
+    uint64_t power = 1;
+    while (power * this->base < (static_cast<uint64_t>(1) << 32)) {
+        power *= this->base;
+        chunkDigits++;
+    }
+    chunkPower = static_cast<uint32_t>(power);
+}
+
+RadixConverter::RadixConverter(const RadixConverter& other)
+    : base(other.base), chunkDigits(other.chunkDigits), chunkPower(other.chunkPower) {
+    std::lock_guard<std::mutex> lock(other.powersMutex);
+    powers = other.powers;
+    inverses = other.inverses;
+}
+
+RadixConverter& RadixConverter::operator=(const RadixConverter& other) {
+    if (this == &other) return *this;
+    std::deque<Limbs> copiedPowers;
+    std::deque<Limbs> copiedInverses;
+    {
+        std::lock_guard<std::mutex> lock(other.powersMutex);
+        copiedPowers = other.powers;
+        copiedInverses = other.inverses;
+    }
+    std::lock_guard<std::mutex> lock(powersMutex);
+    base = other.base;
+    chunkDigits = other.chunkDigits;
+    chunkPower = other.chunkPower;
+    powers.swap(copiedPowers);
+    inverses.swap(copiedInverses);
+    return *this;
+}
+
+const Limbs& RadixConverter::power(size_t level) const {
+    std::lock_guard<std::mutex> lock(powersMutex);
+    if (powers.empty()) {
+        powers.push_back(Limbs(1, chunkPower));
+    }
+    // Each level squares the previous one
+    while (powers.size() <= level) {
+        powers.push_back(multiplyLimbs(powers.back(), powers.back()));
+    }
+    return powers[level];
+}
+
+const Limbs& RadixConverter::inverse(size_t level) const {
+    const Limbs& divisor = power(level);
+    std::lock_guard<std::mutex> lock(powersMutex);
+    while (inverses.size() <= level) {
+        inverses.push_back(Limbs());
+    }
+    // Computed at most once per level; short powers keep an empty reciprocal
+    if (inverses[level].empty() && divisor.size() >= NEWTON_LIMBS) {
+        inverses[level] = reciprocalLimbs(divisor);
+    }
+    return inverses[level];
+}
+
+Limbs RadixConverter::digitsToLimbs(const Numeral& value, size_t from, size_t count) const {
+    // Short runs: Horner's rule, one limb-sized chunk of digits at a time
+    if (count <= chunkDigits * 16) {
+        Limbs result;
+        uint32_t chunk = 0;
+        uint32_t scale = 1;
+        for (size_t i = from + count; i-- > from; ) {
+            chunk = chunk * base + (i < value.digits.size() ? value.digits[i] : 0);
+            scale *= base;
+            if (scale == chunkPower || i == from) {
+                result = multiplyBySmall(result, scale);
+                if (chunk != 0) result = addLimbs(result, Limbs(1, chunk));
+                chunk = 0;
+                scale = 1;
+            }
+        }
+        return result;
+    }
+
+    // Split at the largest cached power below the run length: value = high * base^half + low
+    size_t level = 0;
+    while ((chunkDigits << (level + 1)) < count) level++;
+    size_t half = chunkDigits << level;
+
+    Limbs low = digitsToLimbs(value, from, half);
+    Limbs high = digitsToLimbs(value, from + half, count - half);
+    return addLimbs(multiplyLimbs(high, power(level)), low);
+}
+
+Limbs RadixConverter::toLimbs(const Numeral& value) const {
+    return digitsToLimbs(value, 0, value.digits.size());
+}
+
+void RadixConverter::limbsToDigits(const Limbs& value, size_t level, std::vector<uint8_t>& digits, size_t offset) const {
+    // Writes exactly chunkDigits * 2^level digits of value < power(level)
+    if (value.empty()) return;  // Digits are already zero
+
+    if (level <= 4) {
+        // Short values: peel off one limb-sized chunk per short division
+        Limbs rest = value;
+        size_t end = offset + (chunkDigits << level);
+        for (size_t pos = offset; !rest.empty() && pos < end; pos += chunkDigits) {
+            Limbs quotient;
+            uint32_t chunk = divideBySmall(rest, chunkPower, quotient);
+            rest.swap(quotient);
+            for (size_t d = 0; d < chunkDigits && pos + d < end; d++) {
+                digits[pos + d] = static_cast<uint8_t>(chunk % base);
+                chunk /= base;
+            }
+        }
+        return;
+    }
+
+    // value = high * power(level - 1) + low, both halves below power(level - 1)
+    Limbs low;
+    Limbs high = divideLimbs(value, power(level - 1), inverse(level - 1), low);
+    limbsToDigits(low, level - 1, digits, offset);
+    limbsToDigits(high, level - 1, digits, offset + (chunkDigits << (level - 1)));
+}
+
+Numeral RadixConverter::fromLimbs(const Limbs& value) const {
+    Numeral result;
+    if (value.empty()) return result;
+
+    // Smallest level whose power exceeds the value
+    size_t level = 0;
+    while (compareLimbs(power(level), value) <= 0) level++;
+
+    result.digits.assign(chunkDigits << level, 0);
+    limbsToDigits(value, level, result.digits, 0);
+    result.trim();
+    return result;
+}
@@ -0,0 +1,58 @@
+#ifndef LIMBS_H
+#define LIMBS_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+#include "numeral.h"
+
+// Magnitude in base 2^32 ("limbs"), stored little-endian (limbs[0] is the
+// least significant). No leading zero limbs; zero has no limbs.
+// 32-bit limbs keep every limb product inside a portable 64-bit integer
+typedef std::vector<uint32_t> Limbs;
+
+int compareLimbs(const Limbs& a, const Limbs& b);  // 1 if a > b, -1 if a < b, 0 if equal
+Limbs addLimbs(const Limbs& a, const Limbs& b);
+Limbs subtractLimbs(const Limbs& a, const Limbs& b);  // Requires a >= b
+Limbs multiplyLimbs(const Limbs& a, const Limbs& b);  // Schoolbook, Karatsuba for long operands
+Limbs divideLimbs(const Limbs& a, const Limbs& b, Limbs& remainder);  // Requires b != 0; Newton reciprocal for long divisors
+// Reciprocal of a long divisor, reusable for every dividend of at most 2 * b.size() limbs
+// (empty for short divisors, which are divided by schoolbook anyway)
+Limbs reciprocalLimbs(const Limbs& b);
+Limbs divideLimbs(const Limbs& a, const Limbs& b, const Limbs& inverse, Limbs& remainder);  // inverse = reciprocalLimbs(b)
+Limbs gcdLimbs(const Limbs& a, const Limbs& b);
+Limbs powerModLimbs(const Limbs& value, const Limbs& exponent, const Limbs& modulus);  // Requires modulus != 0
+
+// Conversion between a numeral's base cycle length digits and limbs for one algebra.
+// Both directions split the number in halves at cached powers base^(k * 2^j)
+// (divide and conquer), so a conversion costs O(M(n) log n) instead of O(n^2)
+class RadixConverter {
+public:
+    explicit RadixConverter(int base = 2);
+    RadixConverter(const RadixConverter& other);
+    RadixConverter& operator=(const RadixConverter& other);
+
+    int getBase() const { return base; }
+    Limbs toLimbs(const Numeral& value) const;  // Sign is ignored
+    Numeral fromLimbs(const Limbs& value) const;
+
+private:
+    int base;
+    size_t chunkDigits;   // Digits per limb: the largest k with base^k < 2^32
+    uint32_t chunkPower;  // base^chunkDigits
+
+    // powers[j] = base^(chunkDigits * 2^j) and inverses[j] = reciprocalLimbs(powers[j]),
+    // grown on demand; a deque keeps references to computed entries valid while it grows
+    mutable std::deque<Limbs> powers;
+    mutable std::deque<Limbs> inverses;
+    mutable std::mutex powersMutex;
+
+    const Limbs& power(size_t level) const;
+    const Limbs& inverse(size_t level) const;
+    Limbs digitsToLimbs(const Numeral& value, size_t from, size_t count) const;
+    void limbsToDigits(const Limbs& value, size_t level, std::vector<uint8_t>& digits, size_t offset) const;
+};
+
+#endif // LIMBS_H
@@ -1,6 +1,8 @@
 #include "algebra.h"
 #include <iostream>
 #include <string>
+#include <cstdlib>
+#include <stdexcept>
 
 using namespace std;
 
@@ -38,20 +40,67 @@ void printMenu(int bits) {
     cout << "Choose an option: ";
 }
 
-int main() {
-    cout << "Enter number of elements (e.g., 8 for Z8, 16 for Z16): ";
-    int bits;
-    cin >> bits;
-    
-    if (bits < 2 || bits > 26) {
-        cout << "⚠ Invalid number! Must be between 2 and 26.\n";
-        return 1;
+void printUsage(const char* program) {
+    cout << "Usage: " << program << "\n";
+    cout << "       " << program << " --save-image FILE BITS RULE   Compile an algebra into an image file\n";
+    cout << "       " << program << " --load-image FILE             Start with a compiled image\n";
+}
+
+int main(int argc, char* argv[]) {
+    // Compiled images (algebra_image.h): save one and exit, or start from one
+    string imagePath;
+    if (argc > 1) {
+        string flag = argv[1];
+        if (flag == "--save-image" && argc == 5) {
+            int bits = atoi(argv[3]);
+            if (bits < 2 || bits > 26) {
+                cout << "⚠ Invalid number! Must be between 2 and 26.\n";
+                return 1;
+            }
+            try {
+                Algebra algebra(bits);
+                algebra.setPlusOneRule(argv[4]);
+                algebra.saveImage(argv[2]);
+            } catch (const exception& e) {
+                cout << "⚠ " << e.what() << "\n";
+                return 1;
+            }
+            cout << "✓ Saved Z" << bits << " with rule " << argv[4] << " to " << argv[2] << "\n";
+            return 0;
+        } else if (flag == "--load-image" && argc == 3) {
+            imagePath = argv[2];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
     }
     
-    Algebra algebra(bits);
+    Algebra algebra;
+    int bits;
     string rule;
     bool ruleSet = false;
     
+    if (!imagePath.empty()) {
+        try {
+            algebra.loadImage(imagePath);
+        } catch (const exception& e) {
+            cout << "⚠ " << e.what() << "\n";
+            return 1;
+        }
+        bits = static_cast<int>(algebra.getElements().size());
+        ruleSet = true;
+        cout << "✓ Loaded Z" << bits << " from " << imagePath << "\n";
+    } else {
+        cout << "Enter number of elements (e.g., 8 for Z8, 16 for Z16): ";
+        cin >> bits;
+        
+        if (bits < 2 || bits > 26) {
+            cout << "⚠ Invalid number! Must be between 2 and 26.\n";
+            return 1;
+        }
+        algebra = Algebra(bits);
+    }
+    
     char lastElement = 'a' + bits - 1;
     
     cout << "Welcome to Finite Algebra Calculator!\n";
@@ -143,10 +143,17 @@ void MainWindow::createCalculatorSection(QWidget* parent, QVBoxLayout* layout)
     input2->setPlaceholderText("e.g., h or -cd");
     input2->setMinimumHeight(35);
     
+    QLabel* input3Label = new QLabel("Modulus (for ^ mod):");
+    input3 = new QLineEdit();
+    input3->setPlaceholderText("e.g., dh");
+    input3->setMinimumHeight(35);
+    
     layout->addWidget(input1Label);
     layout->addWidget(input1);
     layout->addWidget(input2Label);
     layout->addWidget(input2);
+    layout->addWidget(input3Label);
+    layout->addWidget(input3);
     layout->addSpacing(20);
     
     // Result display
@@ -170,6 +177,7 @@ void MainWindow::createCalculatorSection(QWidget* parent, QVBoxLayout* layout)
     btnMultiply = new QPushButton("×");
     btnDivide = new QPushButton("÷");
     btnPower = new QPushButton("^");
+    btnPowMod = new QPushButton("^ mod");
     btnMod = new QPushButton("mod");
     btnGcd = new QPushButton("NOD");
     btnLcm = new QPushButton("NOC");
@@ -178,7 +186,7 @@ void MainWindow::createCalculatorSection(QWidget* parent, QVBoxLayout* layout)
     
     // Set button sizes
     QList<QPushButton*> buttons = {btnAdd, btnSubtract, btnMultiply, btnDivide, 
-                                    btnPower, btnMod, btnGcd, btnLcm, btnEquals, btnClear};
+                                    btnPower, btnPowMod, btnMod, btnGcd, btnLcm, btnEquals, btnClear};
     for (auto btn : buttons) {
         btn->setMinimumHeight(50);
         btn->setMinimumWidth(80);
@@ -201,7 +209,8 @@ void MainWindow::createCalculatorSection(QWidget* parent, QVBoxLayout* layout)
     buttonLayout->addWidget(btnGcd, 2, 0);
     buttonLayout->addWidget(btnLcm, 2, 1);
     buttonLayout->addWidget(btnEquals, 2, 2);
-    buttonLayout->addWidget(btnClear, 3, 0, 1, 3);
+    buttonLayout->addWidget(btnPowMod, 3, 0);
+    buttonLayout->addWidget(btnClear, 4, 0, 1, 3);
     
     layout->addWidget(buttonGroup);
     layout->addStretch();
@@ -212,6 +221,7 @@ void MainWindow::createCalculatorSection(QWidget* parent, QVBoxLayout* layout)
     connect(btnMultiply, &QPushButton::clicked, this, &MainWindow::onMultiplyClicked);
     connect(btnDivide, &QPushButton::clicked, this, &MainWindow::onDivideClicked);
     connect(btnPower, &QPushButton::clicked, this, &MainWindow::onPowerClicked);
+    connect(btnPowMod, &QPushButton::clicked, this, &MainWindow::onPowModClicked);
     connect(btnMod, &QPushButton::clicked, this, &MainWindow::onModClicked);
     connect(btnGcd, &QPushButton::clicked, this, &MainWindow::onGcdClicked);
     connect(btnLcm, &QPushButton::clicked, this, &MainWindow::onLcmClicked);
@@ -337,8 +347,8 @@ void MainWindow::onPlusOneRuleChanged()
     if (algebra) {
         delete algebra;
     }
-    algebra = new Algebra(bits);
-    algebra->setPlusOneRule(rule.toStdString());
+    // A copy of the cached compiled algebra: only bounded mode changes afterwards
+    algebra = new Algebra(*AlgebraCache::shared().get(bits, rule.toStdString()));
     algebra->setBoundedMode(boundedModeCheckBox->isChecked());
     algebraInitialized = true;
     
@@ -361,12 +371,13 @@ void MainWindow::performOperation(const std::string& operation)
         return;
     }
     
-    if (!validateInputs()) {
+    if (!validateInputs(operation == "powmod")) {
         return;
     }
     
     std::string num1 = input1->text().toStdString();
     std::string num2 = input2->text().toStdString();
+    std::string num3 = operation == "powmod" ? input3->text().toStdString() : "";
     std::string result;
     
     try {
@@ -395,6 +406,8 @@ void MainWindow::performOperation(const std::string& operation)
             return;
         } else if (operation == "power") {
             result = algebra->powerArithmetic(num1, num2);
+        } else if (operation == "powmod") {
+            result = algebra->powModArithmetic(num1, num2, num3);
         } else if (operation == "mod") {
             result = algebra->modArithmetic(num1, num2);
         } else if (operation == "gcd") {
@@ -408,7 +421,7 @@ void MainWindow::performOperation(const std::string& operation)
         resultDisplay->setText(QString::fromStdString(formattedResult));
         
         // Add to history
-        addToHistory(num1, num2, operation, formattedResult);
+        addToHistory(num1, num2, operation, formattedResult, num3);
         
     } catch (const std::exception& e) {
         QMessageBox::critical(this, "Error", 
@@ -416,7 +429,7 @@ void MainWindow::performOperation(const std::string& operation)
     }
 }
 
-bool MainWindow::validateInputs()
+bool MainWindow::validateInputs(bool needModulus)
 {
     if (input1->text().trimmed().isEmpty() || input2->text().trimmed().isEmpty()) {
         QMessageBox::warning(this, "Invalid Input", 
@@ -424,9 +437,16 @@ bool MainWindow::validateInputs()
         return false;
     }
     
+    if (needModulus && input3->text().trimmed().isEmpty()) {
+        QMessageBox::warning(this, "Invalid Input", 
+            "Please enter the modulus.");
+        return false;
+    }
+    
     // Validate characters
     std::string num1 = input1->text().toStdString();
     std::string num2 = input2->text().toStdString();
+    std::string num3 = needModulus ? input3->text().toStdString() : "";
     
     // Get the last element dynamically from the algebra
     if (!algebra) {
@@ -447,7 +467,7 @@ bool MainWindow::validateInputs()
         return true;
     };
     
-    if (!validateNumber(num1) || !validateNumber(num2)) {
+    if (!validateNumber(num1) || !validateNumber(num2) || !validateNumber(num3)) {
         QMessageBox::warning(this, "Invalid Input", 
             QString("Numbers must contain only elements from 'a' to '%1' (with optional '-' at start).").arg(lastElem));
         return false;
@@ -486,6 +506,12 @@ void MainWindow::onPowerClicked()
     performOperation("power");
 }
 
+void MainWindow::onPowModClicked()
+{
+    currentOperation = "powmod";
+    performOperation("powmod");
+}
+
 void MainWindow::onModClicked()
 {
     currentOperation = "mod";
@@ -521,6 +547,7 @@ void MainWindow::onClearClicked()
     plusOneRuleInput->clear();
     input1->clear();
     input2->clear();
+    input3->clear();
     resultDisplay->clear();
     currentOperation = "";
     
@@ -564,42 +591,25 @@ void MainWindow::onTable2TypeChanged(int index)
 
 void MainWindow::updateTableDisplay(QTextEdit* display, int tableType)
 {
-    // Capture output to string
-    std::ostringstream oss;
-    std::streambuf* oldCoutBuf = std::cout.rdbuf();
-    std::cout.rdbuf(oss.rdbuf());
-    
     switch (tableType) {
         case 0: // Hasse Diagram
             displayHasseDiagram(display);
-            std::cout.rdbuf(oldCoutBuf);
             return;
         case 1: // Addition Table
-            algebra->printAdditionTable();
-            break;
         case 2: // Multiplication Table
-            algebra->printMultiplicationTable();
-            break;
         case 3: // Subtraction Table
-            algebra->printSubtractionTable();
-            break;
         case 4: // Division Table
-            algebra->printDivisionTable();
-            break;
         case 5: // Addition Carry Table
-            algebra->printAdditionCarryTable();
-            break;
         case 6: // Multiplication Carry Table
-            algebra->printMultiplicationCarryTable();
             break;
         default:
-            std::cout.rdbuf(oldCoutBuf);
             display->setPlainText("Unknown table type.");
             return;
     }
     
-    std::cout.rdbuf(oldCoutBuf);
-    display->setPlainText(QString::fromStdString(oss.str()));
+    // Combo box entries 1-6 follow the TableKind order
+    OperationTable table = algebra->exportTable(static_cast<TableKind>(tableType - 1));
+    display->setPlainText(QString::fromStdString(renderTable(table, FORMAT_TEXT)));
 }
 
 void MainWindow::displayHasseDiagram(QTextEdit* display)
@@ -634,12 +644,14 @@ void MainWindow::onBoundedModeChanged(int state)
 }
 
 void MainWindow::addToHistory(const std::string& num1, const std::string& num2, 
-                               const std::string& operation, const std::string& result)
+                               const std::string& operation, const std::string& result,
+                               const std::string& num3)
 {
     // Create history entry
     HistoryEntry entry;
     entry.num1 = num1;
     entry.num2 = num2;
+    entry.num3 = num3;
     entry.operation = operation;
     entry.result = result;
     
@@ -666,6 +678,7 @@ void MainWindow::updateHistoryDisplay()
         if (op == "multiply") return "×";
         if (op == "divide") return "÷";
         if (op == "power") return "^";
+        if (op == "powmod") return "^";
         if (op == "mod") return "mod";
         if (op == "gcd") return "NOD";
         if (op == "lcm") return "NOC";
@@ -678,7 +691,7 @@ void MainWindow::updateHistoryDisplay()
             .arg(index)
             .arg(QString::fromStdString(entry.num1))
             .arg(getOpSymbol(entry.operation))
-            .arg(QString::fromStdString(entry.num2))
+            .arg(QString::fromStdString(entry.num3.empty() ? entry.num2 : entry.num2 + " mod " + entry.num3))
             .arg(QString::fromStdString(entry.result));
         
         historyListWidget->addItem(display);
@@ -697,6 +710,7 @@ void MainWindow::onHistoryItemClicked(QListWidgetItem* item)
         // Load values back into input fields
         input1->setText(QString::fromStdString(entry.num1));
         input2->setText(QString::fromStdString(entry.num2));
+        input3->setText(QString::fromStdString(entry.num3));
         
         // Set current operation
         currentOperation = entry.operation;
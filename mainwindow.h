@@ -15,6 +15,7 @@
 #include <QListWidget>
 #include <deque>
 #include "algebra.h"
+#include "algebra_cache.h"
 #include "hassediagramwidget.h"
 
 class MainWindow : public QMainWindow
@@ -29,6 +30,7 @@ private:
     struct HistoryEntry {
         std::string num1;
         std::string num2;
+        std::string num3;  // Modulus, only for powmod
         std::string operation;
         std::string result;
     };
@@ -42,6 +44,7 @@ private slots:
     void onMultiplyClicked();
     void onDivideClicked();
     void onPowerClicked();
+    void onPowModClicked();
     void onModClicked();
     void onGcdClicked();
     void onLcmClicked();
@@ -67,10 +70,11 @@ private:
     void updateTableDisplay(QTextEdit* display, int tableType);
     void displayHasseDiagram(QTextEdit* display);
     void performOperation(const std::string& operation);
-    bool validateInputs();
+    bool validateInputs(bool needModulus);
     std::string formatTableAsHtml(const std::string& plainText);
     void addToHistory(const std::string& num1, const std::string& num2, 
-                      const std::string& operation, const std::string& result);
+                      const std::string& operation, const std::string& result,
+                      const std::string& num3 = "");
     void updateHistoryDisplay();
     
     // Algebra engine
@@ -90,12 +94,14 @@ private:
     QLineEdit* plusOneRuleInput;
     QLineEdit* input1;
     QLineEdit* input2;
+    QLineEdit* input3;
     QLineEdit* resultDisplay;
     QPushButton* btnAdd;
     QPushButton* btnSubtract;
     QPushButton* btnMultiply;
     QPushButton* btnDivide;
     QPushButton* btnPower;
+    QPushButton* btnPowMod;
     QPushButton* btnMod;
     QPushButton* btnGcd;
     QPushButton* btnLcm;
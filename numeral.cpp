@@ -0,0 +1,786 @@
+#include "numeral.h"
+#include <algorithm>
+#include <utility>
+#include <atomic>
+
+void Numeral::trim() {
+    while (!digits.empty() && digits.back() == 0) {
+        digits.pop_back();
+    }
+    if (digits.empty()) {
+        negative = false;
+    }
+}
+
+int compareMagnitude(const Numeral& a, const Numeral& b) {
+    // Trimmed numerals: the longer one is larger
+    if (a.digits.size() > b.digits.size()) return 1;
+    if (a.digits.size() < b.digits.size()) return -1;
+
+    // Same length, compare from the most significant digit
+    for (size_t i = a.digits.size(); i-- > 0; ) {
+        if (a.digits[i] > b.digits[i]) return 1;
+        if (a.digits[i] < b.digits[i]) return -1;
+    }
+    return 0;
+}
+
+Numeral addMagnitude(const Numeral& a, const Numeral& b, int base) {
+    const Numeral& longer = a.digits.size() >= b.digits.size() ? a : b;
+    const Numeral& shorter = a.digits.size() >= b.digits.size() ? b : a;
+
+    Numeral result;
+    result.digits.reserve(longer.digits.size() + 1);
+
+    // Process from least significant digit with carry propagation
+    int carry = 0;
+    for (size_t i = 0; i < longer.digits.size(); i++) {
+        int sum = longer.digits[i] + carry;
+        if (i < shorter.digits.size()) sum += shorter.digits[i];
+
+        if (sum >= base) {
+            sum -= base;
+            carry = 1;
+        } else {
+            carry = 0;
+        }
+        result.digits.push_back(static_cast<uint8_t>(sum));
+    }
+    if (carry > 0) {
+        result.digits.push_back(static_cast<uint8_t>(carry));
+    }
+
+    result.trim();
+    return result;
+}
+
+Numeral subtractMagnitude(const Numeral& a, const Numeral& b, int base) {
+    Numeral result;
+    result.digits.reserve(a.digits.size());
+
+    // Process from least significant digit with borrow propagation
+    int borrow = 0;
+    for (size_t i = 0; i < a.digits.size(); i++) {
+        int diff = a.digits[i] - borrow;
+        if (i < b.digits.size()) diff -= b.digits[i];
+
+        if (diff < 0) {
+            diff += base;
+            borrow = 1;
+        } else {
+            borrow = 0;
+        }
+        result.digits.push_back(static_cast<uint8_t>(diff));
+    }
+
+    result.trim();
+    return result;
+}
+
+// Operands shorter than this (in digits) are multiplied by schoolbook.
+// The thresholds are atomic so they can be tuned while batches run on other threads
+static std::atomic<size_t> karatsubaThreshold(96);
+
+// Operands at least this long (in digits) are multiplied by NTT
+static std::atomic<size_t> nttThreshold(512);
+
+void setKaratsubaThreshold(size_t digits) {
+    karatsubaThreshold = digits < 2 ? 2 : digits;
+}
+
+size_t getKaratsubaThreshold() {
+    return karatsubaThreshold;
+}
+
+void setNttThreshold(size_t digits) {
+    nttThreshold = digits < 2 ? 2 : digits;
+}
+
+size_t getNttThreshold() {
+    return nttThreshold;
+}
+
+// Numeral made of digits [from, to) of a
+static Numeral sliceDigits(const Numeral& a, size_t from, size_t to) {
+    Numeral result;
+    if (to > a.digits.size()) to = a.digits.size();
+    if (from < to) {
+        result.digits.assign(a.digits.begin() + from, a.digits.begin() + to);
+    }
+    result.trim();
+    return result;
+}
+
+// acc += x * base^shift; acc must be long enough to hold the sum
+static void addShifted(std::vector<uint8_t>& acc, const Numeral& x, size_t shift, int base) {
+    int carry = 0;
+    for (size_t i = 0; i < x.digits.size() || carry > 0; i++) {
+        int sum = acc[shift + i] + carry;
+        if (i < x.digits.size()) sum += x.digits[i];
+
+        if (sum >= base) {
+            sum -= base;
+            carry = 1;
+        } else {
+            carry = 0;
+        }
+        acc[shift + i] = static_cast<uint8_t>(sum);
+    }
+}
+
+static Numeral takeDigits(std::vector<uint8_t>& digits) {
+    Numeral result;
+    result.digits.swap(digits);
+    result.trim();
+    return result;
+}
+
+// Schoolbook multiplication with delayed carries: digit products are summed
+// per column and normalized to the base in a single pass at the end.
+// A column collects at most min(|a|, |b|) products of at most 25 * 25,
+// which fits 32 bits far beyond the Karatsuba threshold
+static Numeral schoolbookMultiply(const Numeral& a, const Numeral& b, int base) {
+    std::vector<uint32_t> columns(a.digits.size() + b.digits.size(), 0);
+    for (size_t j = 0; j < b.digits.size(); j++) {
+        uint32_t digitB = b.digits[j];
+        if (digitB == 0) continue;
+
+        uint32_t* row = columns.data() + j;
+        for (size_t i = 0; i < a.digits.size(); i++) {
+            row[i] += a.digits[i] * digitB;
+        }
+    }
+
+    std::vector<uint8_t> digits(columns.size());
+    uint32_t carry = 0;
+    for (size_t k = 0; k < columns.size(); k++) {
+        uint32_t cell = columns[k] + carry;
+        digits[k] = static_cast<uint8_t>(cell % base);
+        carry = cell / base;
+    }
+    return takeDigits(digits);
+}
+
+static Numeral karatsubaMultiply(const Numeral& longer, const Numeral& shorter, int base);
+static Numeral nttMultiply(const Numeral& a, const Numeral& b, int base);
+
+// Primes p = c * 2^k + 1 with primitive root 3. Every digit product is below
+// 26^2, so a convolution cell is below 676 * 2^23, far under p1 * p2
+static const uint32_t NTT_PRIME_1 = 998244353;  // 119 * 2^23 + 1
+static const uint32_t NTT_PRIME_2 = 469762049;  // 7 * 2^26 + 1
+static const uint32_t NTT_ROOT = 3;
+static const size_t NTT_MAX_LENGTH = static_cast<size_t>(1) << 23;
+
+Numeral multiplyMagnitude(const Numeral& a, const Numeral& b, int base) {
+    if (a.isZero() || b.isZero()) return Numeral();
+
+    const Numeral& longer = a.digits.size() >= b.digits.size() ? a : b;
+    const Numeral& shorter = a.digits.size() >= b.digits.size() ? b : a;
+    size_t n = longer.digits.size();
+    size_t s = shorter.digits.size();
+
+    // Pick the engine by the shorter operand: schoolbook, Karatsuba or NTT
+    if (s < karatsubaThreshold.load(std::memory_order_relaxed)) return schoolbookMultiply(longer, shorter, base);
+    if (s >= nttThreshold.load(std::memory_order_relaxed) && n + s <= NTT_MAX_LENGTH) return nttMultiply(longer, shorter, base);
+    return karatsubaMultiply(longer, shorter, base);
+}
+
+// Karatsuba: with a = a1 * B^m + a0 and b = b1 * B^m + b0,
+// a * b = z2 * B^2m + (z1 - z2 - z0) * B^m + z0 with three half-size products
+// Recursive products go back through multiplyMagnitude, so each part
+// is again handled by the engine that suits its length
+static Numeral karatsubaMultiply(const Numeral& longer, const Numeral& shorter, int base) {
+    size_t n = longer.digits.size();
+    size_t s = shorter.digits.size();
+    std::vector<uint8_t> acc(n + s, 0);
+
+    // Unbalanced operands: multiply the shorter one by chunks of its own length
+    if (n >= 2 * s) {
+        for (size_t from = 0; from < n; from += s) {
+            Numeral chunk = sliceDigits(longer, from, from + s);
+            addShifted(acc, multiplyMagnitude(chunk, shorter, base), from, base);
+        }
+        return takeDigits(acc);
+    }
+
+    // Split at half of the longer operand; the shorter one is longer than m
+    size_t m = n / 2;
+    Numeral a0 = sliceDigits(longer, 0, m);
+    Numeral a1 = sliceDigits(longer, m, n);
+    Numeral b0 = sliceDigits(shorter, 0, m);
+    Numeral b1 = sliceDigits(shorter, m, s);
+
+    Numeral z0 = multiplyMagnitude(a0, b0, base);
+    Numeral z2 = multiplyMagnitude(a1, b1, base);
+    Numeral z1 = multiplyMagnitude(addMagnitude(a0, a1, base), addMagnitude(b0, b1, base), base);
+    z1 = subtractMagnitude(subtractMagnitude(z1, z0, base), z2, base);
+
+    addShifted(acc, z0, 0, base);
+    addShifted(acc, z1, m, base);
+    addShifted(acc, z2, 2 * m, base);
+    return takeDigits(acc);
+}
+
+static uint32_t powMod(uint64_t value, uint64_t exponent, uint32_t mod) {
+    uint64_t result = 1;
+    value %= mod;
+    while (exponent > 0) {
+        if (exponent & 1) result = result * value % mod;
+        value = value * value % mod;
+        exponent >>= 1;
+    }
+    return static_cast<uint32_t>(result);
+}
+
+// In-place iterative number-theoretic transform modulo mod;
+// the length of a must be a power of two dividing mod - 1
+static void ntt(std::vector<uint32_t>& a, bool invert, uint32_t mod) {
+    size_t length = a.size();
+
+    // Bit-reversal permutation
+    for (size_t i = 1, j = 0; i < length; i++) {
+        size_t bit = length >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(a[i], a[j]);
+    }
+
+    std::vector<uint32_t> twiddles;
+    for (size_t half = 1; half < length; half <<= 1) {
+        // Powers of a primitive (2 * half)-th root of unity
+        uint32_t root = powMod(NTT_ROOT, (mod - 1) / (2 * half), mod);
+        if (invert) root = powMod(root, mod - 2, mod);
+        twiddles.assign(half, 1);
+        for (size_t k = 1; k < half; k++) {
+            twiddles[k] = static_cast<uint32_t>(static_cast<uint64_t>(twiddles[k - 1]) * root % mod);
+        }
+
+        for (size_t start = 0; start < length; start += 2 * half) {
+            uint32_t* low = a.data() + start;
+            uint32_t* high = low + half;
+            for (size_t k = 0; k < half; k++) {
+                uint32_t u = low[k];
+                uint32_t v = static_cast<uint32_t>(static_cast<uint64_t>(high[k]) * twiddles[k] % mod);
+                low[k] = u + v >= mod ? u + v - mod : u + v;
+                high[k] = u >= v ? u - v : u + mod - v;
+            }
+        }
+    }
+
+    if (invert) {
+        uint64_t scale = powMod(length, mod - 2, mod);
+        for (uint32_t& x : a) x = static_cast<uint32_t>(x * scale % mod);
+    }
+}
+
+// Cyclic convolution of the digit sequences modulo mod
+static std::vector<uint32_t> convolve(const Numeral& a, const Numeral& b, size_t length, uint32_t mod) {
+    std::vector<uint32_t> fa(length, 0);
+    std::vector<uint32_t> fb(length, 0);
+    std::copy(a.digits.begin(), a.digits.end(), fa.begin());
+    std::copy(b.digits.begin(), b.digits.end(), fb.begin());
+
+    ntt(fa, false, mod);
+    ntt(fb, false, mod);
+    for (size_t i = 0; i < length; i++) {
+        fa[i] = static_cast<uint32_t>(static_cast<uint64_t>(fa[i]) * fb[i] % mod);
+    }
+    ntt(fa, true, mod);
+    return fa;
+}
+
+// Convolution of the digits over two NTT primes, recombined exactly by CRT,
+// then normalized to the base in a single carry pass
+static Numeral nttMultiply(const Numeral& a, const Numeral& b, int base) {
+    size_t count = a.digits.size() + b.digits.size();
+    size_t length = 1;
+    while (length < count) length <<= 1;
+
+    std::vector<uint32_t> r1 = convolve(a, b, length, NTT_PRIME_1);
+    std::vector<uint32_t> r2 = convolve(a, b, length, NTT_PRIME_2);
+
+    // x = r1 + p1 * ((r2 - r1) * p1^-1 mod p2)
+    const uint64_t inverse = powMod(NTT_PRIME_1, NTT_PRIME_2 - 2, NTT_PRIME_2);
+    std::vector<uint8_t> digits(count);
+    uint64_t carry = 0;
+    for (size_t k = 0; k < count; k++) {
+        uint64_t diff = (r2[k] + NTT_PRIME_2 - r1[k] % NTT_PRIME_2) % NTT_PRIME_2;
+        uint64_t cell = r1[k] + static_cast<uint64_t>(NTT_PRIME_1) * (diff * inverse % NTT_PRIME_2);
+        cell += carry;
+        digits[k] = static_cast<uint8_t>(cell % base);
+        carry = cell / base;
+    }
+    return takeDigits(digits);
+}
+
+// Short division by a single digit, returns the remainder digit
+static int divideByDigit(const std::vector<int>& a, int divisor, int base, std::vector<int>& quotient) {
+    quotient.assign(a.size(), 0);
+    int rem = 0;
+    for (size_t i = a.size(); i-- > 0; ) {
+        int cur = rem * base + a[i];
+        quotient[i] = cur / divisor;
+        rem = cur % divisor;
+    }
+    return rem;
+}
+
+static Numeral toNumeral(const std::vector<int>& digits) {
+    Numeral result;
+    result.digits.assign(digits.begin(), digits.end());
+    result.trim();
+    return result;
+}
+
+Numeral divideMagnitude(const Numeral& a, const Numeral& b, int base, Numeral& remainder) {
+    // Schoolbook long division (Knuth, TAOCP vol. 2, 4.3.1, algorithm D)
+    // in the algebra's base, one quotient digit per step
+    if (compareMagnitude(a, b) < 0) {
+        remainder = a;
+        remainder.negative = false;
+        return Numeral();
+    }
+
+    std::vector<int> u(a.digits.begin(), a.digits.end());
+    std::vector<int> v(b.digits.begin(), b.digits.end());
+    std::vector<int> q;
+    size_t n = v.size();
+    size_t m = u.size() - n;
+
+    // Single digit divisor: short division
+    if (n == 1) {
+        int rem = divideByDigit(u, v[0], base, q);
+        remainder = toNumeral(std::vector<int>(1, rem));
+        return toNumeral(q);
+    }
+
+    // D1: normalize so the leading divisor digit is at least base / 2,
+    // which keeps the quotient digit estimate at most 2 too large
+    int d = base / (v[n - 1] + 1);
+    if (d > 1) {
+        int carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            int cell = v[i] * d + carry;
+            v[i] = cell % base;
+            carry = cell / base;
+        }
+        carry = 0;
+        for (size_t i = 0; i < u.size(); i++) {
+            int cell = u[i] * d + carry;
+            u[i] = cell % base;
+            carry = cell / base;
+        }
+        u.push_back(carry);
+    } else {
+        u.push_back(0);
+    }
+
+    q.assign(m + 1, 0);
+    for (size_t j = m + 1; j-- > 0; ) {
+        // D3: estimate the quotient digit from the leading digits
+        int top = u[j + n] * base + u[j + n - 1];
+        int qhat = top / v[n - 1];
+        int rhat = top % v[n - 1];
+        while (qhat >= base || qhat * v[n - 2] > rhat * base + u[j + n - 2]) {
+            qhat--;
+            rhat += v[n - 1];
+            if (rhat >= base) break;
+        }
+
+        // D4: multiply and subtract qhat * v from the current window
+        int borrow = 0;
+        int carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            int product = qhat * v[i] + carry;
+            carry = product / base;
+            int diff = u[i + j] - product % base - borrow;
+            if (diff < 0) {
+                diff += base;
+                borrow = 1;
+            } else {
+                borrow = 0;
+            }
+            u[i + j] = diff;
+        }
+        int diff = u[j + n] - carry - borrow;
+
+        // D6: the estimate was one too large, add the divisor back
+        if (diff < 0) {
+            u[j + n] = diff + base;
+            qhat--;
+            carry = 0;
+            for (size_t i = 0; i < n; i++) {
+                int sum = u[i + j] + v[i] + carry;
+                if (sum >= base) {
+                    sum -= base;
+                    carry = 1;
+                } else {
+                    carry = 0;
+                }
+                u[i + j] = sum;
+            }
+            u[j + n] = (u[j + n] + carry) % base;
+        } else {
+            u[j + n] = diff;
+        }
+
+        q[j] = qhat;
+    }
+
+    // D8: the remainder is the low part of u divided by the normalization factor
+    u.resize(n);
+    std::vector<int> rem;
+    divideByDigit(u, d, base, rem);
+    remainder = toNumeral(rem);
+    return toNumeral(q);
+}
+
+// Number of digits that fit a Lehmer word: the largest k with base^k < 2^32
+static size_t wordDigits(int base) {
+    if (base < 2) return 1;
+    size_t k = 0;
+    for (uint64_t power = base; power < (static_cast<uint64_t>(1) << 32); power *= base) k++;
+    return k;
+}
+
+// Value of digits [from, from + count) of a, missing digits read as zero
+static uint64_t digitsToWord(const Numeral& a, size_t from, size_t count, int base) {
+    uint64_t word = 0;
+    for (size_t i = from + count; i-- > from; ) {
+        word = word * base + (i < a.digits.size() ? a.digits[i] : 0);
+    }
+    return word;
+}
+
+static Numeral wordToNumeral(uint64_t word, int base) {
+    Numeral result;
+    while (word > 0) {
+        result.digits.push_back(static_cast<uint8_t>(word % base));
+        word /= base;
+    }
+    return result;
+}
+
+// |a| * k for a word-sized k
+static Numeral multiplyByWord(const Numeral& a, uint64_t k, int base) {
+    Numeral result;
+    if (k == 0) return result;
+    result.digits.reserve(a.digits.size() + 12);
+
+    uint64_t carry = 0;
+    for (uint8_t digit : a.digits) {
+        uint64_t cell = digit * k + carry;
+        result.digits.push_back(static_cast<uint8_t>(cell % base));
+        carry = cell / base;
+    }
+    while (carry > 0) {
+        result.digits.push_back(static_cast<uint8_t>(carry % base));
+        carry /= base;
+    }
+    result.trim();
+    return result;
+}
+
+// x * u + y * v for cofactors of opposite signs (or a zero cofactor)
+// whose combination is known to be non-negative
+static Numeral combine(const Numeral& u, int64_t x, const Numeral& v, int64_t y, int base) {
+    if (x >= 0 && y >= 0) {
+        return addMagnitude(multiplyByWord(u, x, base), multiplyByWord(v, y, base), base);
+    }
+    if (x >= 0) {
+        return subtractMagnitude(multiplyByWord(u, x, base), multiplyByWord(v, -y, base), base);
+    }
+    return subtractMagnitude(multiplyByWord(v, y, base), multiplyByWord(u, -x, base), base);
+}
+
+// Binary GCD (Stein's algorithm) of two words
+static uint64_t binaryGcd(uint64_t u, uint64_t v) {
+    if (u == 0) return v;
+    if (v == 0) return u;
+
+    int shift = 0;
+    while (((u | v) & 1) == 0) {
+        u >>= 1;
+        v >>= 1;
+        shift++;
+    }
+    while ((u & 1) == 0) u >>= 1;
+    do {
+        while ((v & 1) == 0) v >>= 1;
+        if (u > v) std::swap(u, v);
+        v -= u;
+    } while (v != 0);
+    return u << shift;
+}
+
+// Signed x * s + y * t for word-sized cofactors
+static Numeral combineSigned(const Numeral& s, int64_t x, const Numeral& t, int64_t y, int base) {
+    Numeral first = multiplyByWord(s, x < 0 ? -x : x, base);
+    first.negative = !first.isZero() && (s.negative != (x < 0));
+    Numeral second = multiplyByWord(t, y < 0 ? -y : y, base);
+    second.negative = !second.isZero() && (t.negative != (y < 0));
+    return addNumerals(first, second, base);
+}
+
+// One Euclid step (u, v) -> (v, u mod v); the cofactors follow as (sv, su - q * sv)
+static void euclidStep(Numeral& u, Numeral& v, int base, Numeral* su, Numeral* sv) {
+    Numeral remainder;
+    Numeral q = divideMagnitude(u, v, base, remainder);
+    u = std::move(v);
+    v = std::move(remainder);
+    if (su) {
+        Numeral next = subtractNumerals(*su, multiplyNumerals(q, *sv, base), base);
+        *su = std::move(*sv);
+        *sv = std::move(next);
+    }
+}
+
+// Lehmer's algorithm (Knuth, TAOCP vol. 2, 4.5.2, algorithm L): run Euclid
+// on the leading word of both numbers while the quotients agree, then
+// apply the accumulated cofactors to the full numbers at once.
+// Reduces u >= v until v fits a word. When su and sv are given they are
+// the signed cofactors of u and v with respect to one original operand,
+// and are carried through the same steps
+static void lehmerReduce(Numeral& u, Numeral& v, int base, Numeral* su, Numeral* sv) {
+    const size_t k = wordDigits(base);
+    while (v.digits.size() > k) {
+        // L1: leading words of u and the digits of v at the same place
+        size_t shift = u.digits.size() - k;
+        int64_t x = static_cast<int64_t>(digitsToWord(u, shift, k, base));
+        int64_t y = static_cast<int64_t>(digitsToWord(v, shift, k, base));
+        int64_t A = 1, B = 0, C = 0, D = 1;
+
+        // L2/L3: single-word Euclid steps while both quotient bounds agree.
+        // Stopping as soon as a bound is not positive keeps the divisions exact
+        while (y + C > 0 && y + D > 0 && x + A > 0 && x + B > 0) {
+            int64_t q = (x + A) / (y + C);
+            if (q != (x + B) / (y + D)) break;
+
+            int64_t t = A - q * C;
+            A = C;
+            C = t;
+            t = B - q * D;
+            B = D;
+            D = t;
+            t = x - q * y;
+            x = y;
+            y = t;
+        }
+
+        // L4: no cofactor step was possible, take one full division step
+        if (B == 0) {
+            euclidStep(u, v, base, su, sv);
+            continue;
+        }
+
+        Numeral nextU = combine(u, A, v, B, base);
+        Numeral nextV = combine(u, C, v, D, base);
+        u = std::move(nextU);
+        v = std::move(nextV);
+        if (su) {
+            Numeral nextSu = combineSigned(*su, A, *sv, B, base);
+            Numeral nextSv = combineSigned(*su, C, *sv, D, base);
+            *su = std::move(nextSu);
+            *sv = std::move(nextSv);
+        }
+    }
+}
+
+Numeral gcdMagnitude(const Numeral& a, const Numeral& b, int base) {
+    Numeral u = a;
+    Numeral v = b;
+    u.negative = false;
+    v.negative = false;
+    if (compareMagnitude(u, v) < 0) std::swap(u, v);
+
+    lehmerReduce(u, v, base, nullptr, nullptr);
+
+    // v fits a word: one division brings u down too, then binary GCD
+    if (v.isZero()) return u;
+    Numeral remainder;
+    divideMagnitude(u, v, base, remainder);
+    uint64_t g = binaryGcd(digitsToWord(v, 0, v.digits.size(), base),
+                           digitsToWord(remainder, 0, remainder.digits.size(), base));
+    return wordToNumeral(g, base);
+}
+
+Numeral extendedGcd(const Numeral& a, const Numeral& b, int base, Numeral& x, Numeral& y) {
+    x = Numeral();
+    y = Numeral();
+    if (a.isZero() && b.isZero()) return Numeral();
+
+    // Track the cofactor of |a| only, y follows from g = a * x + b * y
+    Numeral u = a;
+    Numeral v = b;
+    u.negative = false;
+    v.negative = false;
+    Numeral su;
+    Numeral sv;
+    if (compareMagnitude(u, v) < 0) {
+        std::swap(u, v);
+        sv.digits.push_back(1);
+    } else {
+        su.digits.push_back(1);
+    }
+
+    lehmerReduce(u, v, base, &su, &sv);
+    while (!v.isZero()) {
+        euclidStep(u, v, base, &su, &sv);
+    }
+
+    x = su;
+    if (a.negative) x.negative = !x.isZero() && !x.negative;
+    if (!b.isZero()) {
+        // Exact division: b divides g - a * x
+        Numeral rest = subtractNumerals(u, multiplyNumerals(a, x, base), base);
+        Numeral remainder;
+        y = divideMagnitude(rest, b, base, remainder);
+        y.negative = !y.isZero() && (rest.negative != b.negative);
+    }
+    return u;
+}
+
+bool isOddMagnitude(const Numeral& a, int base) {
+    if (a.isZero()) return false;
+    if (base % 2 == 0) return a.digits[0] % 2 == 1;
+
+    // Odd base: every power of the base is odd, so the parity is that of the digit sum
+    int sum = 0;
+    for (uint8_t digit : a.digits) sum += digit;
+    return sum % 2 == 1;
+}
+
+// Binary digits of a, least significant first
+static std::vector<uint8_t> toBits(const Numeral& a, int base) {
+    std::vector<uint8_t> bits;
+    std::vector<int> rest(a.digits.begin(), a.digits.end());
+    while (!rest.empty()) {
+        std::vector<int> half;
+        bits.push_back(static_cast<uint8_t>(divideByDigit(rest, 2, base, half)));
+        while (!half.empty() && half.back() == 0) half.pop_back();
+        rest.swap(half);
+    }
+    return bits;
+}
+
+// Sliding window exponentiation of x (x^0 = 1). Every product is passed through
+// reduce, which may shrink it in place or return false to abort
+template <typename Reduce>
+static bool windowedPower(const Numeral& x, const Numeral& exponent, int base, Reduce reduce, Numeral& result) {
+    result = Numeral();
+    result.digits.push_back(1);  // Start with 1
+    if (!reduce(result)) return false;
+
+    std::vector<uint8_t> bits = toBits(exponent, base);
+    if (bits.empty()) return true;  // x^0 = 1
+
+    // Window size grows with the exponent; 1 is plain square-and-multiply
+    size_t t = bits.size();
+    int k = t <= 24 ? 1 : t <= 80 ? 3 : t <= 240 ? 4 : t <= 672 ? 5 : 6;
+
+    // Odd powers x, x^3, ..., x^(2^k - 1)
+    std::vector<Numeral> oddPowers(static_cast<size_t>(1) << (k - 1));
+    oddPowers[0] = x;
+    if (!reduce(oddPowers[0])) return false;
+    if (k > 1) {
+        Numeral square = multiplyMagnitude(oddPowers[0], oddPowers[0], base);
+        if (!reduce(square)) return false;
+        for (size_t i = 1; i < oddPowers.size(); i++) {
+            oddPowers[i] = multiplyMagnitude(oddPowers[i - 1], square, base);
+            if (!reduce(oddPowers[i])) return false;
+        }
+    }
+
+    // Left to right over the exponent bits
+    for (size_t i = t; i-- > 0; ) {
+        if (bits[i] == 0) {
+            result = multiplyMagnitude(result, result, base);
+            if (!reduce(result)) return false;
+            continue;
+        }
+
+        // Longest window of at most k bits starting at i and ending in a 1
+        size_t low = i + 1 > static_cast<size_t>(k) ? i + 1 - k : 0;
+        while (bits[low] == 0) low++;
+
+        int window = 0;
+        for (size_t j = i + 1; j-- > low; ) {
+            window = window * 2 + bits[j];
+            result = multiplyMagnitude(result, result, base);
+            if (!reduce(result)) return false;
+        }
+        result = multiplyMagnitude(result, oddPowers[window / 2], base);
+        if (!reduce(result)) return false;
+
+        i = low;
+    }
+    return true;
+}
+
+bool powerMagnitude(const Numeral& value, const Numeral& exponent, int base, size_t maxDigits, Numeral& result) {
+    Numeral x = value;
+    x.negative = false;
+
+    auto fits = [maxDigits](Numeral& n) {
+        return maxDigits == 0 || n.digits.size() <= maxDigits;
+    };
+    return windowedPower(x, exponent, base, fits, result);
+}
+
+Numeral powerModMagnitude(const Numeral& value, const Numeral& exponent, const Numeral& modulus, int base) {
+    // Reduce after every product so intermediates stay below modulus^2
+    auto reduce = [&modulus, base](Numeral& n) {
+        if (compareMagnitude(n, modulus) >= 0) {
+            Numeral remainder;
+            divideMagnitude(n, modulus, base, remainder);
+            n = std::move(remainder);
+        }
+        return true;
+    };
+
+    Numeral x = value;
+    x.negative = false;
+    Numeral result;
+    windowedPower(x, exponent, base, reduce, result);
+    return result;
+}
+
+// Signed addition of a and b with the given signs
+static Numeral addSigned(const Numeral& a, bool aNeg, const Numeral& b, bool bNeg, int base) {
+    // Same sign: add magnitudes and keep the sign
+    if (aNeg == bNeg) {
+        Numeral result = addMagnitude(a, b, base);
+        result.negative = aNeg && !result.isZero();
+        return result;
+    }
+
+    // Different signs: subtract the smaller magnitude from the larger one,
+    // the result takes the sign of the larger
+    int cmp = compareMagnitude(a, b);
+    if (cmp == 0) return Numeral();
+
+    if (cmp > 0) {
+        Numeral result = subtractMagnitude(a, b, base);
+        result.negative = aNeg;
+        return result;
+    }
+    Numeral result = subtractMagnitude(b, a, base);
+    result.negative = bNeg;
+    return result;
+}
+
+Numeral addNumerals(const Numeral& a, const Numeral& b, int base) {
+    return addSigned(a, a.negative, b, b.negative, base);
+}
+
+Numeral subtractNumerals(const Numeral& a, const Numeral& b, int base) {
+    // a - b = a + (-b)
+    return addSigned(a, a.negative, b, !b.negative, base);
+}
+
+Numeral multiplyNumerals(const Numeral& a, const Numeral& b, int base) {
+    Numeral result = multiplyMagnitude(a, b, base);
+    // Negative if signs differ
+    result.negative = (a.negative != b.negative) && !result.isZero();
+    return result;
+}
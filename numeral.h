@@ -0,0 +1,50 @@
+#ifndef NUMERAL_H
+#define NUMERAL_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Multi-digit number of the algebra in positional form.
+// A numeral written with elements (e.g. "-bhg") is an integer in base cycle length:
+// each digit is the position of its element, stored little-endian (digits[0] is the
+// least significant). Zero has no digits and is never negative.
+struct Numeral {
+    bool negative = false;
+    std::vector<uint8_t> digits;
+
+    bool isZero() const { return digits.empty(); }
+    void trim();  // Drop leading zero digits (and the sign of zero)
+};
+
+// Magnitude arithmetic (signs are ignored, results are non-negative)
+int compareMagnitude(const Numeral& a, const Numeral& b);  // 1 if |a| > |b|, -1 if |a| < |b|, 0 if equal
+Numeral addMagnitude(const Numeral& a, const Numeral& b, int base);
+Numeral subtractMagnitude(const Numeral& a, const Numeral& b, int base);  // Requires |a| >= |b|
+Numeral multiplyMagnitude(const Numeral& a, const Numeral& b, int base);  // Schoolbook, Karatsuba or NTT by length
+Numeral divideMagnitude(const Numeral& a, const Numeral& b, int base, Numeral& remainder);  // Requires b != 0
+bool isOddMagnitude(const Numeral& a, int base);
+
+// |value| ^ exponent by squaring, with a sliding window for long exponents.
+// Returns false as soon as an intermediate value has more than maxDigits digits (0 = no limit)
+bool powerMagnitude(const Numeral& value, const Numeral& exponent, int base, size_t maxDigits, Numeral& result);
+Numeral powerModMagnitude(const Numeral& value, const Numeral& exponent, const Numeral& modulus, int base);  // Requires modulus != 0
+
+// Shortest operand length (in digits) at which multiplyMagnitude switches
+// from schoolbook to Karatsuba, and from Karatsuba to NTT
+void setKaratsubaThreshold(size_t digits);
+size_t getKaratsubaThreshold();
+void setNttThreshold(size_t digits);
+size_t getNttThreshold();
+
+// Signed arithmetic
+Numeral addNumerals(const Numeral& a, const Numeral& b, int base);
+Numeral subtractNumerals(const Numeral& a, const Numeral& b, int base);
+Numeral multiplyNumerals(const Numeral& a, const Numeral& b, int base);
+
+// Greatest common divisor of |a| and |b| (Lehmer with a binary GCD tail)
+Numeral gcdMagnitude(const Numeral& a, const Numeral& b, int base);
+// Returns g = gcd(a, b) and signed Bezout coefficients with a * x + b * y = g
+Numeral extendedGcd(const Numeral& a, const Numeral& b, int base, Numeral& x, Numeral& y);
+
+#endif // NUMERAL_H
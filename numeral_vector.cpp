@@ -0,0 +1,164 @@
+#include "numeral_vector.h"
+#include <algorithm>
+#include <utility>
+
+void NumeralVector::resize(size_t count, size_t width) {
+    this->count = count;
+    this->width = width;
+    digits.assign(count * width, 0);
+    lengths.assign(count, 0);
+    negative.assign(count, 0);
+}
+
+Numeral NumeralVector::get(size_t i) const {
+    Numeral value;
+    value.negative = negative[i] != 0;
+    value.digits.resize(lengths[i]);
+    for (size_t k = 0; k < lengths[i]; k++) {
+        value.digits[k] = digits[k * count + i];
+    }
+    return value;
+}
+
+void NumeralVector::set(size_t i, const Numeral& value) {
+    for (size_t k = 0; k < width; k++) {
+        digits[k * count + i] = k < value.digits.size() ? value.digits[k] : 0;
+    }
+    lengths[i] = static_cast<uint32_t>(value.digits.size());
+    negative[i] = value.negative && !value.isZero();
+}
+
+// Recompute the lengths from the digits, clear the sign of zeros and drop
+// the digit rows above the longest numeral (they are last in the layout)
+static void trimVector(NumeralVector& v) {
+    uint32_t* lengths = v.lengths.data();
+    std::fill(v.lengths.begin(), v.lengths.end(), 0);
+    for (size_t k = 0; k < v.width; k++) {
+        const uint8_t* d = v.row(k);
+        uint32_t length = static_cast<uint32_t>(k + 1);
+        for (size_t i = 0; i < v.count; i++) {
+            lengths[i] = d[i] ? length : lengths[i];
+        }
+    }
+
+    size_t width = 0;
+    for (size_t i = 0; i < v.count; i++) {
+        width = std::max<size_t>(width, v.lengths[i]);
+        v.negative[i] = v.lengths[i] ? v.negative[i] : 0;
+    }
+    v.width = width;
+    v.digits.resize(width * v.count);
+}
+
+// a + b, or a - b: per lane the magnitudes are added when the (effective) signs
+// agree, otherwise the smaller is subtracted from the larger. All lanes run the
+// same branch-free digit loop, selecting the operation per lane
+static void addSigned(const NumeralVector& a, const NumeralVector& b, bool subtract, int base, NumeralVector& out) {
+    size_t count = a.count;
+    size_t operandWidth = std::max(a.width, b.width);
+    std::vector<uint8_t> zeros(count, 0);
+    auto rowOf = [&zeros](const NumeralVector& v, size_t k) { return k < v.width ? v.row(k) : zeros.data(); };
+
+    std::vector<uint8_t> same(count), swap(count, 0);
+    bool mixed = false;
+    for (size_t i = 0; i < count; i++) {
+        same[i] = a.negative[i] == (b.negative[i] ^ (subtract ? 1 : 0));
+        mixed |= !same[i];
+    }
+
+    // Lanes with different signs subtract the smaller magnitude from the larger:
+    // compare by length, then by the digits from the top
+    if (mixed) {
+        std::vector<int8_t> order(count);
+        for (size_t i = 0; i < count; i++) {
+            order[i] = static_cast<int8_t>((a.lengths[i] > b.lengths[i]) - (a.lengths[i] < b.lengths[i]));
+        }
+        int8_t* decided = order.data();
+        for (size_t k = operandWidth; k-- > 0; ) {
+            const uint8_t* x = rowOf(a, k);
+            const uint8_t* y = rowOf(b, k);
+            for (size_t i = 0; i < count; i++) {
+                int8_t digitOrder = static_cast<int8_t>((x[i] > y[i]) - (x[i] < y[i]));
+                decided[i] |= digitOrder & -static_cast<int8_t>(decided[i] == 0);
+            }
+        }
+        for (size_t i = 0; i < count; i++) {
+            swap[i] = !same[i] && order[i] < 0;
+        }
+    }
+
+    NumeralVector result;
+    result.resize(count, operandWidth + 1);
+    for (size_t i = 0; i < count; i++) {
+        result.negative[i] = swap[i] ? b.negative[i] ^ (subtract ? 1 : 0) : a.negative[i];
+    }
+
+    // Byte arithmetic with masks instead of branches, so a vector register holds
+    // as many lanes as possible: a sum is high + low + carry, a difference
+    // high + base - low - carry, both below 2 * base; the digit wraps at base
+    // and the carry (borrow) follows
+    const uint8_t radix = static_cast<uint8_t>(base);
+    std::vector<uint8_t> carry(count, 0);
+    uint8_t* carries = carry.data();
+    const uint8_t* sameSign = same.data();
+    const uint8_t* swapped = swap.data();
+    for (size_t k = 0; k < result.width; k++) {
+        const uint8_t* x = rowOf(a, k);
+        const uint8_t* y = rowOf(b, k);
+        uint8_t* d = result.row(k);
+        for (size_t i = 0; i < count; i++) {
+            uint8_t swapMask = static_cast<uint8_t>(-swapped[i]);
+            uint8_t addMask = static_cast<uint8_t>(-sameSign[i]);
+            uint8_t high = static_cast<uint8_t>((x[i] & ~swapMask) | (y[i] & swapMask));
+            uint8_t low = static_cast<uint8_t>(x[i] ^ y[i] ^ high);
+            uint8_t sum = static_cast<uint8_t>(high + low + carries[i]);
+            uint8_t difference = static_cast<uint8_t>(high + radix - low - carries[i]);
+            uint8_t t = static_cast<uint8_t>((sum & addMask) | (difference & ~addMask));
+            uint8_t wrap = t >= radix;
+            d[i] = static_cast<uint8_t>(t - (radix & -wrap));
+            carries[i] = static_cast<uint8_t>(wrap ^ (sameSign[i] ^ 1));
+        }
+    }
+
+    trimVector(result);
+    out = std::move(result);
+}
+
+void addNumeralVectors(const NumeralVector& a, const NumeralVector& b, int base, NumeralVector& out) {
+    addSigned(a, b, false, base, out);
+}
+
+void subtractNumeralVectors(const NumeralVector& a, const NumeralVector& b, int base, NumeralVector& out) {
+    addSigned(a, b, true, base, out);
+}
+
+void multiplyNumeralVectorByDigit(const NumeralVector& a, uint8_t digit, int base, NumeralVector& out) {
+    size_t count = a.count;
+    NumeralVector result;
+    result.resize(count, a.width + 1);
+    result.negative = a.negative;
+
+    // t = digit * x + carry < 2^10 for base <= 32, where the high half of the
+    // 16 x 16 bit product t * reciprocal is exactly t / base; unlike a division
+    // it vectorizes (pmulhuw)
+    const uint16_t reciprocal = static_cast<uint16_t>(65536 / base + 1);
+    std::vector<uint8_t> carry(count, 0);
+    uint8_t* carries = carry.data();
+    for (size_t k = 0; k < result.width; k++) {
+        uint8_t* d = result.row(k);
+        if (k < a.width) {
+            const uint8_t* x = a.row(k);
+            for (size_t i = 0; i < count; i++) {
+                uint16_t t = static_cast<uint16_t>(x[i] * digit + carries[i]);
+                uint16_t q = static_cast<uint16_t>((static_cast<uint32_t>(t) * reciprocal) >> 16);
+                d[i] = static_cast<uint8_t>(t - q * base);
+                carries[i] = static_cast<uint8_t>(q);
+            }
+        } else {
+            std::copy(carry.begin(), carry.end(), d);
+        }
+    }
+
+    trimVector(result);
+    out = std::move(result);
+}
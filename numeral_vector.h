@@ -0,0 +1,33 @@
+#ifndef NUMERAL_VECTOR_H
+#define NUMERAL_VECTOR_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "numeral.h"
+
+// Many numerals in structure-of-arrays layout: digits of the same significance
+// are contiguous, so one operation runs over all numerals a digit row at a time
+// (the carry chains advance in lockstep) with loops the compiler vectorizes
+struct NumeralVector {
+    size_t count = 0;               // Numerals
+    size_t width = 0;               // Digit rows, at least the longest numeral
+    std::vector<uint8_t> digits;    // width * count: digit k of numeral i is digits[k * count + i], zero padded
+    std::vector<uint32_t> lengths;  // Significant digits of each numeral (0 for zero)
+    std::vector<uint8_t> negative;  // Sign of each numeral (never set for zero)
+
+    void resize(size_t count, size_t width);  // count zeros with room for width digits
+    const uint8_t* row(size_t k) const { return digits.data() + k * count; }
+    uint8_t* row(size_t k) { return digits.data() + k * count; }
+
+    Numeral get(size_t i) const;
+    void set(size_t i, const Numeral& value);  // Requires value.digits.size() <= width
+};
+
+// Lane-wise signed arithmetic in base base: out[i] = a[i] op b[i]. a and b must have
+// the same count; out is resized and may be one of the operands
+void addNumeralVectors(const NumeralVector& a, const NumeralVector& b, int base, NumeralVector& out);
+void subtractNumeralVectors(const NumeralVector& a, const NumeralVector& b, int base, NumeralVector& out);
+void multiplyNumeralVectorByDigit(const NumeralVector& a, uint8_t digit, int base, NumeralVector& out);  // Requires digit < base <= 32
+
+#endif // NUMERAL_VECTOR_H
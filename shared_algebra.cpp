@@ -0,0 +1,51 @@
+#include "shared_algebra.h"
+#include "algebra_cache.h"
+
+// snapshot with bounded mode set to enabled: the snapshot itself if it already
+// is, otherwise a private copy (cached snapshots are shared and never modified)
+static std::shared_ptr<const Algebra> withBoundedMode(std::shared_ptr<const Algebra> snapshot, bool enabled) {
+    if (snapshot->isBoundedMode() == enabled) {
+        return snapshot;
+    }
+    std::shared_ptr<Algebra> copy = std::make_shared<Algebra>(*snapshot);
+    copy->setBoundedMode(enabled);
+    return copy;
+}
+
+SharedAlgebra::SharedAlgebra(int bits) : current(std::make_shared<const Algebra>(bits)) {}
+
+SharedAlgebra::SharedAlgebra(std::shared_ptr<const Algebra> snapshot) : current(std::move(snapshot)) {}
+
+std::shared_ptr<const Algebra> SharedAlgebra::snapshot() const {
+    return std::atomic_load(&current);
+}
+
+void SharedAlgebra::configure(int bits, const std::string& rule) {
+    std::lock_guard<std::mutex> lock(configMutex);
+    std::atomic_store(&current, AlgebraCache::shared().get(bits, rule));
+}
+
+void SharedAlgebra::setPlusOneRule(const std::string& rule) {
+    std::lock_guard<std::mutex> lock(configMutex);
+    std::shared_ptr<const Algebra> previous = std::atomic_load(&current);
+    std::shared_ptr<const Algebra> next = AlgebraCache::shared().get(previous->getBits(), rule);
+    std::atomic_store(&current, withBoundedMode(next, previous->isBoundedMode()));
+}
+
+void SharedAlgebra::setBoundedMode(bool enabled) {
+    std::lock_guard<std::mutex> lock(configMutex);
+    std::atomic_store(&current, withBoundedMode(std::atomic_load(&current), enabled));
+}
+
+void SharedAlgebra::loadImage(const std::string& path) {
+    std::lock_guard<std::mutex> lock(configMutex);
+    std::shared_ptr<Algebra> next = std::make_shared<Algebra>();
+    next->loadImage(path);
+    next->setBoundedMode(std::atomic_load(&current)->isBoundedMode());
+    std::atomic_store(&current, std::shared_ptr<const Algebra>(std::move(next)));
+}
+
+void SharedAlgebra::publish(std::shared_ptr<const Algebra> next) {
+    std::lock_guard<std::mutex> lock(configMutex);
+    std::atomic_store(&current, std::move(next));
+}
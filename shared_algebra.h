@@ -0,0 +1,35 @@
+#ifndef SHARED_ALGEBRA_H
+#define SHARED_ALGEBRA_H
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include "algebra.h"
+
+// An algebra that many threads calculate with while it is reconfigured.
+// Every configuration is an immutable snapshot (a const Algebra, shared with
+// AlgebraCache where possible). Readers take the current snapshot with one atomic
+// load and keep it for a whole calculation; reconfiguring builds the next snapshot
+// off to the side and publishes it with an atomic store. Readers never wait for a
+// rule change, and a calculation never sees half of one
+class SharedAlgebra {
+public:
+    explicit SharedAlgebra(int bits = 8);  // No rule set yet
+    explicit SharedAlgebra(std::shared_ptr<const Algebra> snapshot);
+
+    std::shared_ptr<const Algebra> snapshot() const;  // The current snapshot
+
+    // Reconfiguration. Each one replaces the snapshot as a whole; if the new one
+    // cannot be built the exception is passed on and the current snapshot stays
+    void configure(int bits, const std::string& rule);  // Like a new Algebra(bits) with the rule: bounded mode off
+    void setPlusOneRule(const std::string& rule);       // Keeps bits and bounded mode
+    void setBoundedMode(bool enabled);
+    void loadImage(const std::string& path);            // A compiled image (algebra_image.h), keeps bounded mode
+    void publish(std::shared_ptr<const Algebra> next);
+
+private:
+    std::shared_ptr<const Algebra> current;  // Only read and written through std::atomic_load/std::atomic_store
+    std::mutex configMutex;                  // Serializes reconfigurations; readers never take it
+};
+
+#endif // SHARED_ALGEBRA_H
@@ -0,0 +1,243 @@
+#include "table_export.h"
+#include <cstring>
+
+// Appends to a caller-supplied buffer and keeps counting past its capacity,
+// so the caller learns the full length from a truncated write
+class BufferWriter {
+public:
+    BufferWriter(char* out, size_t capacity) : out(out), capacity(capacity), length(0) {}
+
+    void put(char c) {
+        if (length < capacity) out[length] = c;
+        length++;
+    }
+
+    void put(const char* text, size_t count) {
+        if (length < capacity) {
+            size_t room = capacity - length;
+            std::memcpy(out + length, text, count < room ? count : room);
+        }
+        length += count;
+    }
+
+    void put(const std::string& text) { put(text.data(), text.size()); }
+    void put(const char* text) { put(text, std::strlen(text)); }
+
+    void repeat(char c, size_t count) {
+        for (size_t i = 0; i < count; i++) put(c);
+    }
+
+    size_t written() const { return length; }
+
+private:
+    char* out;
+    size_t capacity;
+    size_t length;
+};
+
+static const char* tableTitle(TableKind kind) {
+    switch (kind) {
+        case TABLE_ADDITION: return "Addition Table (+):";
+        case TABLE_MULTIPLICATION: return "Multiplication Table (*):";
+        case TABLE_SUBTRACTION: return "Subtraction Table (-):";
+        case TABLE_DIVISION: return "Division Table (/):";
+        case TABLE_ADDITION_CARRY: return "Addition Carry Table:";
+        case TABLE_MULTIPLICATION_CARRY: return "Multiplication Carry Table:";
+    }
+    return "";
+}
+
+static const char* tableName(TableKind kind) {
+    switch (kind) {
+        case TABLE_ADDITION: return "addition";
+        case TABLE_MULTIPLICATION: return "multiplication";
+        case TABLE_SUBTRACTION: return "subtraction";
+        case TABLE_DIVISION: return "division";
+        case TABLE_ADDITION_CARRY: return "addition_carry";
+        case TABLE_MULTIPLICATION_CARRY: return "multiplication_carry";
+    }
+    return "";
+}
+
+static void renderText(const OperationTable& table, BufferWriter& writer) {
+    size_t n = table.size();
+    const char* title = tableTitle(table.kind);
+
+    writer.put('\n');
+    writer.put(title);
+    writer.put('\n');
+    writer.repeat('=', std::strlen(title));
+    writer.put('\n');
+
+    // Header
+    writer.put(table.symbol());
+    writer.put("    |");
+    for (char e : table.elements) {
+        writer.put("  ");
+        writer.put(e);
+        writer.put("    ");
+    }
+    writer.put("\n-----|");
+    writer.repeat('-', 7 * n);
+    writer.put('\n');
+
+    // Rows, every label centered in a 7-char cell
+    for (size_t row = 0; row < n; row++) {
+        writer.put(table.elements[row]);
+        writer.put("    |");
+        for (size_t col = 0; col < n; col++) {
+            const std::string& display = table.cellLabel(row * n + col);
+            size_t width = display.length() < 7 ? display.length() : 7;
+            size_t padding = (7 - width) / 2;
+            writer.repeat(' ', padding);
+            writer.put(display);
+            writer.repeat(' ', 7 - padding - width);
+        }
+        writer.put("\n\n");  // Extra vertical space
+    }
+    writer.put('\n');
+}
+
+static void putCsvField(const std::string& field, BufferWriter& writer) {
+    if (field.find_first_of(",\"") == std::string::npos) {
+        writer.put(field);
+        return;
+    }
+    writer.put('"');
+    for (char c : field) {
+        if (c == '"') writer.put('"');
+        writer.put(c);
+    }
+    writer.put('"');
+}
+
+static void renderCsv(const OperationTable& table, BufferWriter& writer) {
+    size_t n = table.size();
+    writer.put(table.symbol());
+    for (char e : table.elements) {
+        writer.put(',');
+        writer.put(e);
+    }
+    writer.put('\n');
+
+    for (size_t row = 0; row < n; row++) {
+        writer.put(table.elements[row]);
+        for (size_t col = 0; col < n; col++) {
+            writer.put(',');
+            putCsvField(table.cellLabel(row * n + col), writer);
+        }
+        writer.put('\n');
+    }
+}
+
+static void putJsonString(const std::string& text, BufferWriter& writer) {
+    writer.put('"');
+    for (char c : text) {
+        if (c == '"' || c == '\\') writer.put('\\');
+        writer.put(c);
+    }
+    writer.put('"');
+}
+
+static void putNumber(unsigned value, BufferWriter& writer) {
+    char digits[10];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (count > 0) writer.put(digits[--count]);
+}
+
+static void renderJson(const OperationTable& table, BufferWriter& writer) {
+    size_t n = table.size();
+    writer.put("{\"kind\":\"");
+    writer.put(tableName(table.kind));
+    writer.put("\",\"symbol\":\"");
+    writer.put(table.symbol());
+    writer.put("\",\"elements\":[");
+    for (size_t i = 0; i < n; i++) {
+        if (i > 0) writer.put(',');
+        writer.put('"');
+        writer.put(table.elements[i]);
+        writer.put('"');
+    }
+
+    // Raw cells: result element ids, or carry counts
+    writer.put("],\"cells\":[");
+    for (size_t row = 0; row < n; row++) {
+        writer.put(row > 0 ? ",[" : "[");
+        for (size_t col = 0; col < n; col++) {
+            if (col > 0) writer.put(',');
+            putNumber(table.cells[row * n + col], writer);
+        }
+        writer.put(']');
+    }
+
+    writer.put("],\"labels\":[");
+    for (size_t row = 0; row < n; row++) {
+        writer.put(row > 0 ? ",[" : "[");
+        for (size_t col = 0; col < n; col++) {
+            if (col > 0) writer.put(',');
+            putJsonString(table.cellLabel(row * n + col), writer);
+        }
+        writer.put(']');
+    }
+    writer.put("]}");
+}
+
+static void renderBinary(const OperationTable& table, BufferWriter& writer) {
+    size_t n = table.size();
+    writer.put("ALGT", 4);
+    writer.put(static_cast<char>(1));  // Version
+    writer.put(static_cast<char>(table.kind));
+    writer.put(static_cast<char>(n));
+    writer.put(static_cast<char>(0));
+    writer.put(table.elements.data(), n);
+    for (int pos : table.positions) {
+        writer.put(static_cast<char>(pos < 0 ? 0xFF : pos));
+    }
+    writer.put(reinterpret_cast<const char*>(table.cells.data()), table.cells.size());
+}
+
+char OperationTable::symbol() const {
+    switch (kind) {
+        case TABLE_ADDITION:
+        case TABLE_ADDITION_CARRY: return '+';
+        case TABLE_MULTIPLICATION:
+        case TABLE_MULTIPLICATION_CARRY: return '*';
+        case TABLE_SUBTRACTION: return '-';
+        case TABLE_DIVISION: return '/';
+    }
+    return '?';
+}
+
+const std::string& OperationTable::cellLabel(size_t cell) const {
+    static const std::string unknown = "?";
+
+    // A carry count is shown as the element at that position,
+    // a result as the label of the result element's position
+    int position = cells[cell];
+    if (!isCarryTable()) {
+        position = cells[cell] < positions.size() ? positions[cells[cell]] : -1;
+    }
+    if (position < 0 || position >= static_cast<int>(labels.size())) return unknown;
+    return labels[position];
+}
+
+size_t renderTable(const OperationTable& table, TableFormat format, char* out, size_t capacity) {
+    BufferWriter writer(out, capacity);
+    switch (format) {
+        case FORMAT_TEXT: renderText(table, writer); break;
+        case FORMAT_CSV: renderCsv(table, writer); break;
+        case FORMAT_JSON: renderJson(table, writer); break;
+        case FORMAT_BINARY: renderBinary(table, writer); break;
+    }
+    return writer.written();
+}
+
+std::string renderTable(const OperationTable& table, TableFormat format) {
+    std::string result(renderTable(table, format, nullptr, 0), '\0');
+    renderTable(table, format, &result[0], result.size());
+    return result;
+}
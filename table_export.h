@@ -0,0 +1,57 @@
+#ifndef TABLE_EXPORT_H
+#define TABLE_EXPORT_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Operation tables that can be exported. The values are part of the C API
+// (algebra_c_wrapper.cpp), so they must not be reordered
+enum TableKind {
+    TABLE_ADDITION = 0,
+    TABLE_MULTIPLICATION = 1,
+    TABLE_SUBTRACTION = 2,
+    TABLE_DIVISION = 3,
+    TABLE_ADDITION_CARRY = 4,
+    TABLE_MULTIPLICATION_CARRY = 5
+};
+
+enum TableFormat {
+    FORMAT_TEXT = 0,    // Same layout as the console tables
+    FORMAT_CSV = 1,     // Header row of elements, then one row per element with display labels
+    FORMAT_JSON = 2,    // {"kind", "symbol", "elements", "cells", "labels"}
+    FORMAT_BINARY = 3   // See renderTable
+};
+
+// Snapshot of one compiled table, independent of the algebra that produced it
+struct OperationTable {
+    TableKind kind = TABLE_ADDITION;
+    std::vector<char> elements;       // Element of each id, the row and column headers
+    std::vector<int> positions;       // Position of each element id (-1 if unmapped)
+    std::vector<std::string> labels;  // Display label of each position, e.g. "{d,f}"
+
+    // n x n row-major cells, cell = id(a) * n + id(b): the result element id,
+    // or the number of carries for the carry tables
+    std::vector<uint8_t> cells;
+
+    size_t size() const { return elements.size(); }
+    bool isCarryTable() const { return kind == TABLE_ADDITION_CARRY || kind == TABLE_MULTIPLICATION_CARRY; }
+    char symbol() const;                           // '+', '*', '-' or '/'
+    const std::string& cellLabel(size_t cell) const;  // Display label of a cell ("?" if it has none)
+};
+
+// Writes the table in the given format into out, in one pass.
+// Returns the full length in bytes; when it exceeds capacity only the first
+// capacity bytes are written, so a call with capacity 0 queries the length.
+// No terminating NUL is written.
+//
+// Binary layout (n = number of elements):
+//   "ALGT", version (1), kind, n, 0 (reserved)
+//   n element characters
+//   n positions, 0xFF for unmapped elements
+//   n * n cells as above
+size_t renderTable(const OperationTable& table, TableFormat format, char* out, size_t capacity);
+std::string renderTable(const OperationTable& table, TableFormat format);
+
+#endif // TABLE_EXPORT_H
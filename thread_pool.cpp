@@ -0,0 +1,136 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+    }
+
+    for (unsigned i = 0; i < threads; i++) {
+        queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    }
+    for (unsigned i = 1; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, static_cast<size_t>(i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::run(size_t count, const std::function<void(size_t)>& task) {
+    std::lock_guard<std::mutex> runLock(runMutex);
+
+    // Nothing to share: run on the calling thread
+    if (workers.empty() || count < 2) {
+        for (size_t i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    // Contiguous blocks keep neighbouring tasks on one thread until stealing starts
+    size_t participants = queues.size();
+    for (size_t p = 0; p < participants; p++) {
+        std::lock_guard<std::mutex> lock(queues[p]->mutex);
+        for (size_t i = p * count / participants; i < (p + 1) * count / participants; i++) {
+            queues[p]->tasks.push_back(i);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        this->task = &task;
+        error = nullptr;
+        joined = 0;
+        active = 0;
+        generation++;
+    }
+    wake.notify_all();
+
+    work(0, task);
+
+    // Every worker must have picked up this run and finished it before the
+    // queues and the task are reused
+    std::exception_ptr failure;
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        finished.wait(lock, [this] { return joined == workers.size() && active == 0; });
+        this->task = nullptr;
+        failure = error;
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    size_t seen = 0;
+    std::unique_lock<std::mutex> lock(stateMutex);
+    while (true) {
+        wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+        if (stopping) return;
+
+        seen = generation;
+        const std::function<void(size_t)>& current = *task;
+        joined++;
+        active++;
+        lock.unlock();
+
+        work(index, current);
+
+        lock.lock();
+        active--;
+        finished.notify_all();
+    }
+}
+
+void ThreadPool::work(size_t index, const std::function<void(size_t)>& current) {
+    size_t taskIndex;
+    while (takeTask(index, taskIndex)) {
+        try {
+            current(taskIndex);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            if (!error) error = std::current_exception();
+        }
+    }
+}
+
+bool ThreadPool::takeTask(size_t index, size_t& taskIndex) {
+    // Own queue first, from the front
+    {
+        Queue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            taskIndex = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    // Then steal from the back of the others, starting with the next participant.
+    // Queues only shrink during a run, so one empty sweep means all work is taken
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        Queue& victim = *queues[(index + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            taskIndex = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,62 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <memory>
+#include <cstddef>
+
+// Work-stealing thread pool for data-parallel loops.
+// run(count, task) deals the tasks 0..count-1 out in contiguous blocks, one
+// queue per participant (the workers and the calling thread). Each participant
+// takes tasks from the front of its own queue and, once that is empty, steals
+// from the back of the others, so tasks of very different cost balance out
+// without tuning the block sizes
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads = 0);  // Participants including the caller, 0 = hardware threads
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(queues.size()); }
+
+    // Runs task(i) for every i in [0, count) and returns when all are done.
+    // One run at a time: concurrent calls wait for each other.
+    // If tasks throw, the remaining tasks still run and the first exception is rethrown
+    void run(size_t count, const std::function<void(size_t)>& task);
+
+    static ThreadPool& shared();  // Process-wide pool with one participant per hardware thread
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;  // queues[0] belongs to the caller of run
+    std::vector<std::thread> workers;            // workers[i] owns queues[i + 1]
+
+    std::mutex runMutex;  // Serializes run
+    std::mutex stateMutex;
+    std::condition_variable wake;      // A new run started, or the pool stops
+    std::condition_variable finished;  // A worker finished its part of the run
+    const std::function<void(size_t)>* task = nullptr;
+    size_t generation = 0;  // Number of runs started
+    size_t joined = 0;      // Workers that picked up the current run
+    size_t active = 0;      // Workers still working on it
+    bool stopping = false;
+    std::exception_ptr error;
+
+    void workerLoop(size_t index);
+    void work(size_t index, const std::function<void(size_t)>& current);
+    bool takeTask(size_t index, size_t& taskIndex);
+};
+
+#endif // THREAD_POOL_H
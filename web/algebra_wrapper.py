@@ -10,7 +10,7 @@ from pathlib import Path
 # Load the shared library
 lib_path = os.path.join(os.path.dirname(__file__), '..', 'libalgebra.so')
 if not os.path.exists(lib_path):
-    raise RuntimeError(f"Shared library not found at {lib_path}. Please compile with: g++ -shared -fPIC -O3 algebra.cpp algebra_c_wrapper.cpp -o libalgebra.so -std=c++17")
+    raise RuntimeError(f"Shared library not found at {lib_path}. Please compile with: g++ -shared -fPIC -O3 algebra.cpp numeral.cpp limbs.cpp table_export.cpp thread_pool.cpp element_kernels.cpp numeral_vector.cpp algebra_cache.cpp algebra_image.cpp shared_algebra.cpp algebra_c_wrapper.cpp -o libalgebra.so -std=c++17")
 
 _lib = ctypes.CDLL(lib_path)
 
@@ -21,11 +21,32 @@ _lib.algebra_create.restype = ctypes.c_void_p
 _lib.algebra_destroy.argtypes = [ctypes.c_void_p]
 _lib.algebra_destroy.restype = None
 
+_lib.algebra_snapshot.argtypes = [ctypes.c_void_p]
+_lib.algebra_snapshot.restype = ctypes.c_void_p
+
 _lib.algebra_set_plus_one_rule.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
-_lib.algebra_set_plus_one_rule.restype = None
+_lib.algebra_set_plus_one_rule.restype = ctypes.c_int
+
+_lib.algebra_configure.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_char_p]
+_lib.algebra_configure.restype = ctypes.c_int
+
+_lib.algebra_cache_set_capacity.argtypes = [ctypes.c_int]
+_lib.algebra_cache_set_capacity.restype = None
+
+_lib.algebra_cache_size.argtypes = []
+_lib.algebra_cache_size.restype = ctypes.c_int
+
+_lib.algebra_save_image.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+_lib.algebra_save_image.restype = ctypes.c_int
+
+_lib.algebra_load_image.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+_lib.algebra_load_image.restype = ctypes.c_int
+
+_lib.algebra_cache_preload.argtypes = [ctypes.c_char_p]
+_lib.algebra_cache_preload.restype = ctypes.c_int
 
 _lib.algebra_set_bounded_mode.argtypes = [ctypes.c_void_p, ctypes.c_bool]
-_lib.algebra_set_bounded_mode.restype = None
+_lib.algebra_set_bounded_mode.restype = ctypes.c_int
 
 _lib.algebra_get_bounded_mode.argtypes = [ctypes.c_void_p]
 _lib.algebra_get_bounded_mode.restype = ctypes.c_bool
@@ -36,10 +57,81 @@ _lib.algebra_multiply_arithmetic.argtypes = [ctypes.c_void_p, ctypes.c_char_p, c
 _lib.algebra_divide_arithmetic.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_char_p, ctypes.c_int]
 _lib.algebra_power_arithmetic.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
 _lib.algebra_mod_arithmetic.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
+_lib.algebra_powmod_arithmetic.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
 _lib.algebra_gcd_arithmetic.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
 _lib.algebra_lcm_arithmetic.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
+_lib.algebra_extended_gcd_arithmetic.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_char_p, ctypes.c_int, ctypes.c_char_p, ctypes.c_int]
+_lib.algebra_mod_inverse_arithmetic.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
 _lib.algebra_format_result.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
 
+# Result functions return the full length of their text; it stays readable
+# in the handle through algebra_last_result until the next call
+for _name in ['add', 'subtract', 'multiply', 'divide', 'power', 'mod', 'powmod', 'gcd', 'lcm',
+              'extended_gcd', 'mod_inverse']:
+    getattr(_lib, f'algebra_{_name}_arithmetic').restype = ctypes.c_int
+_lib.algebra_format_result.restype = ctypes.c_int
+
+_lib.algebra_last_result.argtypes = [ctypes.c_void_p, ctypes.c_int]
+_lib.algebra_last_result.restype = ctypes.c_void_p
+
+_lib.algebra_last_result_length.argtypes = [ctypes.c_void_p, ctypes.c_int]
+_lib.algebra_last_result_length.restype = ctypes.c_int
+
+_lib.algebra_render_table.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int, ctypes.c_char_p, ctypes.c_int]
+_lib.algebra_render_table.restype = ctypes.c_int
+
+_lib.algebra_export_table.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(ctypes.c_uint8), ctypes.c_int]
+_lib.algebra_export_table.restype = ctypes.c_int
+
+_lib.algebra_export_carry_table.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(ctypes.c_uint8), ctypes.c_int]
+_lib.algebra_export_carry_table.restype = ctypes.c_int
+
+# Table kinds and formats, same values as TableKind and TableFormat in table_export.h
+TABLE_KINDS = {
+    'addition': 0,
+    'multiplication': 1,
+    'subtraction': 2,
+    'division': 3,
+    'addition_carry': 4,
+    'multiplication_carry': 5,
+}
+TABLE_FORMATS = {'text': 0, 'csv': 1, 'json': 2, 'binary': 3}
+
+_lib.algebra_evaluate_batch.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(ctypes.c_uint8), ctypes.c_char_p,
+                                        ctypes.POINTER(ctypes.c_uint32), ctypes.c_int, ctypes.c_char_p, ctypes.c_int,
+                                        ctypes.POINTER(ctypes.c_uint32), ctypes.POINTER(ctypes.c_uint8)]
+_lib.algebra_evaluate_batch.restype = ctypes.c_int
+
+_lib.algebra_copy_batch_results.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int]
+_lib.algebra_copy_batch_results.restype = ctypes.c_int
+
+_lib.algebra_set_batch_threads.argtypes = [ctypes.c_void_p, ctypes.c_int]
+_lib.algebra_set_batch_threads.restype = ctypes.c_int
+
+_lib.algebra_apply_elementwise.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
+_lib.algebra_apply_elementwise.restype = ctypes.c_int
+
+_lib.algebra_kernel_isa.argtypes = []
+_lib.algebra_kernel_isa.restype = ctypes.c_char_p
+
+# Single-digit operations of apply_elementwise, same values as the TableKind of their table
+ELEMENTWISE_OPS = {'add': 0, 'multiply': 1, 'subtract': 2, 'divide': 3}
+
+# Batch operations, same values as BatchOpcode in batch.h
+BATCH_OPCODES = {
+    'add': 0,
+    'subtract': 1,
+    'multiply': 2,
+    'divide': 3,
+    'remainder': 4,
+    'mod': 5,
+    'power': 6,
+    'powmod': 7,
+    'gcd': 8,
+    'lcm': 9,
+    'mod_inverse': 10,
+}
+
 _lib.algebra_get_element_count.argtypes = [ctypes.c_void_p]
 _lib.algebra_get_element_count.restype = ctypes.c_int
 
@@ -61,6 +153,15 @@ _lib.algebra_subtract_single.restype = ctypes.c_char
 _lib.algebra_divide_single.argtypes = [ctypes.c_void_p, ctypes.c_char, ctypes.c_char]
 _lib.algebra_divide_single.restype = ctypes.c_char
 
+_lib.algebra_power_single.argtypes = [ctypes.c_void_p, ctypes.c_char, ctypes.c_char]
+_lib.algebra_power_single.restype = ctypes.c_char
+
+_lib.algebra_gcd_single.argtypes = [ctypes.c_void_p, ctypes.c_char, ctypes.c_char]
+_lib.algebra_gcd_single.restype = ctypes.c_char
+
+_lib.algebra_lcm_single.argtypes = [ctypes.c_void_p, ctypes.c_char, ctypes.c_char]
+_lib.algebra_lcm_single.restype = ctypes.c_char
+
 _lib.algebra_get_addition_carry.argtypes = [ctypes.c_void_p, ctypes.c_char, ctypes.c_char]
 _lib.algebra_get_addition_carry.restype = ctypes.c_int
 
@@ -74,10 +175,10 @@ _lib.algebra_get_plus_one_rule_outputs.argtypes = [ctypes.c_void_p, ctypes.c_int
 _lib.algebra_get_plus_one_rule_outputs.restype = ctypes.c_int
 
 _lib.algebra_get_max_value.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int]
-_lib.algebra_get_max_value.restype = None
+_lib.algebra_get_max_value.restype = ctypes.c_int
 
 _lib.algebra_get_min_value.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int]
-_lib.algebra_get_min_value.restype = None
+_lib.algebra_get_min_value.restype = ctypes.c_int
 
 
 class Algebra:
@@ -86,6 +187,9 @@ class Algebra:
     def __init__(self, bits=8):
         self.bits = bits
         self._handle = _lib.algebra_create(bits)
+        if not self._handle:
+            raise MemoryError("Cannot create algebra")
+        self._table_buffers = {}  # Table kind -> ctypes buffer reused by export_table
         self.initialized = False
     
     def __del__(self):
@@ -94,72 +198,148 @@ class Algebra:
     
     def set_plus_one_rule(self, rule):
         """Set the +1 rule"""
-        _lib.algebra_set_plus_one_rule(self._handle, rule.encode('utf-8'))
+        if not _lib.algebra_set_plus_one_rule(self._handle, rule.encode('utf-8')):
+            raise RuntimeError(self._last_result(0))
+        self.initialized = True
+    
+    def configure(self, bits, rule):
+        """Switch to bits elements with the +1 rule (bounded mode off) in one step.
+        Calculations on snapshots taken before keep the previous algebra"""
+        if not _lib.algebra_configure(self._handle, bits, rule.encode('utf-8')):
+            raise RuntimeError(self._last_result(0))
+        self.bits = bits
         self.initialized = True
     
+    def snapshot(self):
+        """An Algebra fixed to the current configuration, with its own results:
+        take one per request so concurrent requests and rule changes do not mix"""
+        view = Algebra.__new__(Algebra)
+        view.initialized = self.initialized  # Before the snapshot: it is at least as new
+        view._handle = _lib.algebra_snapshot(self._handle)
+        if not view._handle:
+            raise MemoryError("Cannot take a snapshot")
+        view.bits = _lib.algebra_get_element_count(view._handle)
+        view._table_buffers = {}
+        return view
+    
+    def save_image(self, path):
+        """Write the compiled algebra to a binary image file"""
+        if not _lib.algebra_save_image(self._handle, os.fsencode(path)):
+            raise RuntimeError(f"Cannot write algebra image {path}")
+    
+    def load_image(self, path):
+        """Replace the algebra with a compiled image (bits and rule come from the file)"""
+        if not _lib.algebra_load_image(self._handle, os.fsencode(path)):
+            raise RuntimeError(f"Cannot load algebra image {path}")
+        self.bits = _lib.algebra_get_element_count(self._handle)
+        self.initialized = True
+    
+    @staticmethod
+    def preload_image(path):
+        """Add a compiled image to the cache used by set_plus_one_rule"""
+        if not _lib.algebra_cache_preload(os.fsencode(path)):
+            raise RuntimeError(f"Cannot load algebra image {path}")
+    
     def set_bounded_mode(self, enabled):
         """Enable/disable bounded mode"""
-        _lib.algebra_set_bounded_mode(self._handle, enabled)
+        if not _lib.algebra_set_bounded_mode(self._handle, enabled):
+            raise RuntimeError(self._last_result(0))
     
     def get_bounded_mode(self):
         """Check if bounded mode is enabled"""
         return _lib.algebra_get_bounded_mode(self._handle)
     
+    def _last_result(self, slot, length=None):
+        """Full text of a result kept in the handle: no fixed buffer, no truncation"""
+        if length is None:
+            length = _lib.algebra_last_result_length(self._handle, slot)
+        return ctypes.string_at(_lib.algebra_last_result(self._handle, slot), length).decode('utf-8')
+    
+    def _check(self, length):
+        """Raise ValueError with the error text of a failed calculation (negative length)"""
+        if length < 0:
+            raise ValueError(self._last_result(0))
+    
+    def _element(self, result):
+        """Element returned by a single-digit operation; ValueError if it failed ('\\0')"""
+        if result in (b'\0', 0):
+            raise ValueError(self._last_result(0))
+        return result.decode('utf-8') if isinstance(result, bytes) else chr(result)
+    
     def add_arithmetic(self, a, b):
         """Add two multi-digit numbers"""
-        result = ctypes.create_string_buffer(1024)
-        _lib.algebra_add_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'), result, 1024)
-        return result.value.decode('utf-8')
+        length = _lib.algebra_add_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'), None, 0)
+        self._check(length)
+        return self._last_result(0, length)
     
     def subtract_arithmetic(self, a, b):
         """Subtract two multi-digit numbers"""
-        result = ctypes.create_string_buffer(1024)
-        _lib.algebra_subtract_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'), result, 1024)
-        return result.value.decode('utf-8')
+        length = _lib.algebra_subtract_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'), None, 0)
+        self._check(length)
+        return self._last_result(0, length)
     
     def multiply_arithmetic(self, a, b):
         """Multiply two multi-digit numbers"""
-        result = ctypes.create_string_buffer(1024)
-        _lib.algebra_multiply_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'), result, 1024)
-        return result.value.decode('utf-8')
+        length = _lib.algebra_multiply_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'), None, 0)
+        self._check(length)
+        return self._last_result(0, length)
     
     def divide_arithmetic(self, a, b):
         """Divide two multi-digit numbers, return (quotient, remainder)"""
-        quotient = ctypes.create_string_buffer(1024)
-        remainder = ctypes.create_string_buffer(1024)
-        _lib.algebra_divide_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'), 
-                                      quotient, 1024, remainder, 1024)
-        return quotient.value.decode('utf-8'), remainder.value.decode('utf-8')
+        length = _lib.algebra_divide_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'),
+                                                None, 0, None, 0)
+        self._check(length)
+        return self._last_result(0, length), self._last_result(1)
     
     def power_arithmetic(self, base, exp):
         """Calculate base^exp"""
-        result = ctypes.create_string_buffer(1024)
-        _lib.algebra_power_arithmetic(self._handle, base.encode('utf-8'), exp.encode('utf-8'), result, 1024)
-        return result.value.decode('utf-8')
+        length = _lib.algebra_power_arithmetic(self._handle, base.encode('utf-8'), exp.encode('utf-8'), None, 0)
+        self._check(length)
+        return self._last_result(0, length)
     
     def mod_arithmetic(self, a, b):
         """Calculate a mod b"""
-        result = ctypes.create_string_buffer(1024)
-        _lib.algebra_mod_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'), result, 1024)
-        return result.value.decode('utf-8')
+        length = _lib.algebra_mod_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'), None, 0)
+        self._check(length)
+        return self._last_result(0, length)
+    
+    def powmod_arithmetic(self, base, exp, modulus):
+        """Calculate (base^exp) mod modulus"""
+        length = _lib.algebra_powmod_arithmetic(self._handle, base.encode('utf-8'), exp.encode('utf-8'),
+                                                modulus.encode('utf-8'), None, 0)
+        self._check(length)
+        return self._last_result(0, length)
     
     def gcd_arithmetic(self, a, b):
         """Calculate GCD/NOD of a and b"""
-        result = ctypes.create_string_buffer(1024)
-        _lib.algebra_gcd_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'), result, 1024)
-        return result.value.decode('utf-8')
+        length = _lib.algebra_gcd_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'), None, 0)
+        self._check(length)
+        return self._last_result(0, length)
+    
+    def extended_gcd_arithmetic(self, a, b):
+        """Extended GCD, return (gcd, x, y) with a*x + b*y = gcd"""
+        length = _lib.algebra_extended_gcd_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'),
+                                                      None, 0, None, 0, None, 0)
+        self._check(length)
+        return self._last_result(0, length), self._last_result(1), self._last_result(2)
+    
+    def mod_inverse_arithmetic(self, a, modulus):
+        """Calculate the inverse of a modulo modulus (∅ if it does not exist)"""
+        length = _lib.algebra_mod_inverse_arithmetic(self._handle, a.encode('utf-8'), modulus.encode('utf-8'), None, 0)
+        self._check(length)
+        return self._last_result(0, length)
     
     def lcm_arithmetic(self, a, b):
         """Calculate LCM/NOC of a and b"""
-        result = ctypes.create_string_buffer(1024)
-        _lib.algebra_lcm_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'), result, 1024)
-        return result.value.decode('utf-8')
+        length = _lib.algebra_lcm_arithmetic(self._handle, a.encode('utf-8'), b.encode('utf-8'), None, 0)
+        self._check(length)
+        return self._last_result(0, length)
     
     def format_result(self, input_str):
         """Format result with position notation"""
-        result = ctypes.create_string_buffer(2048)
-        _lib.algebra_format_result(self._handle, input_str.encode('utf-8'), result, 2048)
-        return result.value.decode('utf-8')
+        length = _lib.algebra_format_result(self._handle, input_str.encode('utf-8'), None, 0)
+        self._check(length)
+        return self._last_result(0, length)
     
     def get_elements(self):
         """Get list of all elements"""
@@ -184,28 +364,49 @@ class Algebra:
         a_byte = a.encode('utf-8')[0] if isinstance(a, str) else a
         b_byte = b.encode('utf-8')[0] if isinstance(b, str) else b
         result = _lib.algebra_add_single(self._handle, a_byte, b_byte)
-        return result.decode('utf-8') if isinstance(result, bytes) else chr(result)
+        return self._element(result)
     
     def multiply_single(self, a, b):
         """Multiply two single elements"""
         a_byte = a.encode('utf-8')[0] if isinstance(a, str) else a
         b_byte = b.encode('utf-8')[0] if isinstance(b, str) else b
         result = _lib.algebra_multiply_single(self._handle, a_byte, b_byte)
-        return result.decode('utf-8') if isinstance(result, bytes) else chr(result)
+        return self._element(result)
     
     def subtract_single(self, a, b):
         """Subtract two single elements"""
         a_byte = a.encode('utf-8')[0] if isinstance(a, str) else a
         b_byte = b.encode('utf-8')[0] if isinstance(b, str) else b
         result = _lib.algebra_subtract_single(self._handle, a_byte, b_byte)
-        return result.decode('utf-8') if isinstance(result, bytes) else chr(result)
+        return self._element(result)
     
     def divide_single(self, a, b):
         """Divide two single elements"""
         a_byte = a.encode('utf-8')[0] if isinstance(a, str) else a
         b_byte = b.encode('utf-8')[0] if isinstance(b, str) else b
         result = _lib.algebra_divide_single(self._handle, a_byte, b_byte)
-        return result.decode('utf-8') if isinstance(result, bytes) else chr(result)
+        return self._element(result)
+    
+    def power_single(self, base, exponent):
+        """Raise a single element to a single element power"""
+        base_byte = base.encode('utf-8')[0] if isinstance(base, str) else base
+        exp_byte = exponent.encode('utf-8')[0] if isinstance(exponent, str) else exponent
+        result = _lib.algebra_power_single(self._handle, base_byte, exp_byte)
+        return self._element(result)
+    
+    def gcd_single(self, a, b):
+        """GCD/NOD of two single elements"""
+        a_byte = a.encode('utf-8')[0] if isinstance(a, str) else a
+        b_byte = b.encode('utf-8')[0] if isinstance(b, str) else b
+        result = _lib.algebra_gcd_single(self._handle, a_byte, b_byte)
+        return self._element(result)
+    
+    def lcm_single(self, a, b):
+        """LCM/NOC of two single elements"""
+        a_byte = a.encode('utf-8')[0] if isinstance(a, str) else a
+        b_byte = b.encode('utf-8')[0] if isinstance(b, str) else b
+        result = _lib.algebra_lcm_single(self._handle, a_byte, b_byte)
+        return self._element(result)
     
     def get_addition_carry(self, a, b):
         """Get carry for addition of two elements"""
@@ -221,69 +422,159 @@ class Algebra:
     
     def get_max_value(self):
         """Get maximum value for bounded mode"""
-        result = ctypes.create_string_buffer(1024)
-        _lib.algebra_get_max_value(self._handle, result, 1024)
-        return result.value.decode('utf-8')
+        length = _lib.algebra_get_max_value(self._handle, None, 0)
+        self._check(length)
+        return self._last_result(0, length)
     
     def get_min_value(self):
         """Get minimum value for bounded mode"""
-        result = ctypes.create_string_buffer(1024)
-        _lib.algebra_get_min_value(self._handle, result, 1024)
-        return result.value.decode('utf-8')
+        length = _lib.algebra_get_min_value(self._handle, None, 0)
+        self._check(length)
+        return self._last_result(0, length)
     
-    def get_addition_table(self):
-        """Generate addition table"""
+    def apply_elementwise(self, op, a, b):
+        """Single-digit op over two equally long element strings in one call: result[i] = a[i] op b[i]"""
+        if len(a) != len(b):
+            raise ValueError("Operands must have the same length")
+        count = len(a)
+        out = ctypes.create_string_buffer(count)
+        self._check(_lib.algebra_apply_elementwise(self._handle, ELEMENTWISE_OPS[op], a.encode('utf-8'),
+                                                   b.encode('utf-8'), out, count))
+        return out.raw[:count].decode('utf-8')
+    
+    @staticmethod
+    def set_cache_capacity(capacity):
+        """Number of compiled algebras kept for set_plus_one_rule (0 disables the cache)"""
+        _lib.algebra_cache_set_capacity(capacity)
+    
+    @staticmethod
+    def cache_size():
+        """Number of compiled algebras in the cache"""
+        return _lib.algebra_cache_size()
+    
+    @staticmethod
+    def kernel_isa():
+        """Instruction set of the element-wise kernels"""
+        return _lib.algebra_kernel_isa().decode('utf-8')
+    
+    def set_batch_threads(self, threads):
+        """Threads for evaluate_batch: 0 = all cores (default), 1 = no threads"""
+        if not _lib.algebra_set_batch_threads(self._handle, threads):
+            raise RuntimeError(self._last_result(0))
+    
+    def evaluate_batch(self, operations, format=False):
+        """Evaluate (op, a, b[, c]) tuples in one call.
+        Returns a list of (ok, text): the result, or the error message if ok is False"""
+        count = len(operations)
+        opcodes = (ctypes.c_uint8 * max(count, 1))()
+        operand_offsets = (ctypes.c_uint32 * (3 * count + 1))()
+        packed = bytearray()
+        for i, operation in enumerate(operations):
+            op, operands = operation[0], list(operation[1:])
+            if op not in BATCH_OPCODES:
+                raise ValueError(f"Unknown batch operation {op}")
+            opcodes[i] = BATCH_OPCODES[op]
+            operands += [''] * (3 - len(operands))
+            for k, operand in enumerate(operands[:3]):
+                operand_offsets[3 * i + k] = len(packed)
+                packed += str(operand).encode('utf-8')
+        operand_offsets[3 * count] = len(packed)
+        
+        result_offsets = (ctypes.c_uint32 * (count + 1))()
+        status = (ctypes.c_uint8 * max(count, 1))()
+        size = 64 * count + 64
+        out = ctypes.create_string_buffer(size)
+        length = _lib.algebra_evaluate_batch(self._handle, count, opcodes, bytes(packed), operand_offsets,
+                                             1 if format else 0, out, size, result_offsets, status)
+        self._check(length)
+        if length > size:
+            # Too small: fetch the kept results instead of evaluating again
+            out = ctypes.create_string_buffer(length)
+            _lib.algebra_copy_batch_results(self._handle, out, length)
+        
+        data = out.raw[:length]
+        return [(status[i] == 0, data[result_offsets[i]:result_offsets[i + 1]].decode('utf-8'))
+                for i in range(count)]
+    
+    def render_table(self, kind, fmt='text'):
+        """Render a whole table in one call: text, csv, json (str) or binary (bytes)"""
+        kind_id = TABLE_KINDS[kind]
+        format_id = TABLE_FORMATS[fmt]
+        size = 4096
+        while True:
+            result = ctypes.create_string_buffer(size)
+            length = _lib.algebra_render_table(self._handle, kind_id, format_id, result, size)
+            self._check(length)
+            if length < size:
+                break
+            size = length + 1  # Too small: the call reported the full length
+        data = result.raw[:length]
+        return data if fmt == 'binary' else data.decode('utf-8')
+    
+    def export_table(self, kind):
+        """Fill a whole table in one call and return an n x n memoryview of it
+        (result element ids, or carry counts for the carry tables).
+        The view shares its buffer with the wrapper: no copy is made, and the next
+        export of the same kind overwrites it"""
+        n = _lib.algebra_get_element_count(self._handle)
+        buffer = self._table_buffers.get(kind)
+        if buffer is None or len(buffer) != n * n:
+            buffer = (ctypes.c_uint8 * (n * n))()
+            self._table_buffers[kind] = buffer
+        
+        if kind in ('addition_carry', 'multiplication_carry'):
+            written = _lib.algebra_export_carry_table(self._handle, TABLE_KINDS[kind] - 4, buffer, n * n)
+        else:
+            written = _lib.algebra_export_table(self._handle, TABLE_KINDS[kind], buffer, n * n)
+        self._check(written)
+        if written != n * n:
+            raise ValueError(f"Cannot export table {kind}")
+        return memoryview(buffer).cast('B').cast('B', (n, n))
+    
+    def _element_table(self, kind):
+        """Table as {(a, b): result element}"""
         elements = self.get_elements()
+        cells = self.export_table(kind)
         table = {}
-        for a in elements:
-            for b in elements:
-                table[(a, b)] = self.add_single(a, b)
+        for i, a in enumerate(elements):
+            for j, b in enumerate(elements):
+                cell = cells[i, j]
+                table[(a, b)] = elements[cell] if cell < len(elements) else '?'
         return table
     
-    def get_multiplication_table(self):
-        """Generate multiplication table"""
+    def _carry_table(self, kind):
+        """Carry table as {(a, b): carry count}"""
         elements = self.get_elements()
+        cells = self.export_table(kind)
         table = {}
-        for a in elements:
-            for b in elements:
-                table[(a, b)] = self.multiply_single(a, b)
+        for i, a in enumerate(elements):
+            for j, b in enumerate(elements):
+                table[(a, b)] = cells[i, j]
         return table
     
+    def get_addition_table(self):
+        """Generate addition table"""
+        return self._element_table('addition')
+    
+    def get_multiplication_table(self):
+        """Generate multiplication table"""
+        return self._element_table('multiplication')
+    
     def get_subtraction_table(self):
         """Generate subtraction table"""
-        elements = self.get_elements()
-        table = {}
-        for a in elements:
-            for b in elements:
-                table[(a, b)] = self.subtract_single(a, b)
-        return table
+        return self._element_table('subtraction')
     
     def get_division_table(self):
         """Generate division table"""
-        elements = self.get_elements()
-        table = {}
-        for a in elements:
-            for b in elements:
-                table[(a, b)] = self.divide_single(a, b)
-        return table
+        return self._element_table('division')
     
     def get_addition_carry_table(self):
         """Generate addition carry table"""
-        elements = self.get_elements()
-        table = {}
-        for a in elements:
-            for b in elements:
-                table[(a, b)] = self.get_addition_carry(a, b)
-        return table
+        return self._carry_table('addition_carry')
     
     def get_multiplication_carry_table(self):
         """Generate multiplication carry table"""
-        elements = self.get_elements()
-        table = {}
-        for a in elements:
-            for b in elements:
-                table[(a, b)] = self.get_multiplication_carry(a, b)
-        return table
+        return self._carry_table('multiplication_carry')
     
     def get_hasse_diagram_data(self):
         """Get Hasse diagram structure with element positions and plus one rule"""
@@ -2,15 +2,34 @@
 Flask web server for Algebra Calculator
 """
 
+import json
+import os
+from pathlib import Path
 from flask import Flask, render_template, request, jsonify
 from flask_cors import CORS
-from algebra_wrapper import Algebra
+from algebra_wrapper import Algebra, TABLE_KINDS, BATCH_OPCODES
 
 app = Flask(__name__)
 CORS(app)
 
-# Global algebra instance
-algebra = None
+# Global algebra instance, shared by all requests. /api/init reconfigures it in
+# place; every other request calculates on a snapshot taken when it starts, so
+# a rule change never waits for, or mixes into, a calculation in progress
+algebra = Algebra()
+
+def preload_images():
+    """Load the precompiled algebras (algebra --save-image) in $ALGEBRA_IMAGES into the
+    cache, so /api/init with their rules does not compile them again"""
+    directory = os.environ.get('ALGEBRA_IMAGES')
+    if not directory:
+        return
+    for image in sorted(Path(directory).glob('*.alg')):
+        try:
+            Algebra.preload_image(str(image))
+        except RuntimeError as e:
+            app.logger.warning(str(e))
+
+preload_images()
 
 @app.route('/')
 def index():
@@ -20,20 +39,19 @@ def index():
 @app.route('/api/init', methods=['POST'])
 def init_algebra():
     """Initialize algebra with bits and +1 rule"""
-    global algebra
     data = request.json
     bits = int(data.get('bits', 8))
     rule = data.get('rule', '')
     
     try:
-        algebra = Algebra(bits)
-        algebra.set_plus_one_rule(rule)
+        algebra.configure(bits, rule)
+        current = algebra.snapshot()
         
         return jsonify({
             'success': True,
             'message': f'Algebra Z{bits} initialized',
-            'elements': algebra.get_elements(),
-            'hasse': algebra.get_hasse_diagram_data()
+            'elements': current.get_elements(),
+            'hasse': current.get_hasse_diagram_data()
         })
     except Exception as e:
         return jsonify({'success': False, 'error': str(e)}), 400
@@ -41,39 +59,48 @@ def init_algebra():
 @app.route('/api/calculate', methods=['POST'])
 def calculate():
     """Perform calculation"""
-    global algebra
-    if not algebra or not algebra.initialized:
+    if not algebra.initialized:
         return jsonify({'success': False, 'error': 'Algebra not initialized'}), 400
+    current = algebra.snapshot()
     
     data = request.json
     num1 = data.get('num1', '')
     num2 = data.get('num2', '')
+    num3 = data.get('num3', '')
     operation = data.get('operation', '')
     
     try:
         result = None
         remainder = None
+        coefficients = None
         
         if operation == 'add':
-            result = algebra.add_arithmetic(num1, num2)
+            result = current.add_arithmetic(num1, num2)
         elif operation == 'subtract':
-            result = algebra.subtract_arithmetic(num1, num2)
+            result = current.subtract_arithmetic(num1, num2)
         elif operation == 'multiply':
-            result = algebra.multiply_arithmetic(num1, num2)
+            result = current.multiply_arithmetic(num1, num2)
         elif operation == 'divide':
-            result, remainder = algebra.divide_arithmetic(num1, num2)
+            result, remainder = current.divide_arithmetic(num1, num2)
         elif operation == 'power':
-            result = algebra.power_arithmetic(num1, num2)
+            result = current.power_arithmetic(num1, num2)
         elif operation == 'mod':
-            result = algebra.mod_arithmetic(num1, num2)
+            result = current.mod_arithmetic(num1, num2)
+        elif operation == 'powmod':
+            result = current.powmod_arithmetic(num1, num2, num3)
         elif operation == 'gcd':
-            result = algebra.gcd_arithmetic(num1, num2)
+            result = current.gcd_arithmetic(num1, num2)
         elif operation == 'lcm':
-            result = algebra.lcm_arithmetic(num1, num2)
+            result = current.lcm_arithmetic(num1, num2)
+        elif operation == 'egcd':
+            result, x, y = current.extended_gcd_arithmetic(num1, num2)
+            coefficients = (x, y)
+        elif operation == 'modinv':
+            result = current.mod_inverse_arithmetic(num1, num2)
         else:
             return jsonify({'success': False, 'error': 'Unknown operation'}), 400
         
-        formatted_result = algebra.format_result(result)
+        formatted_result = current.format_result(result)
         
         response = {
             'success': True,
@@ -81,48 +108,60 @@ def calculate():
         }
         
         if remainder is not None:
-            response['remainder'] = algebra.format_result(remainder)
+            response['remainder'] = current.format_result(remainder)
+        
+        if coefficients is not None:
+            response['x'] = current.format_result(coefficients[0])
+            response['y'] = current.format_result(coefficients[1])
         
         return jsonify(response)
     except Exception as e:
         return jsonify({'success': False, 'error': str(e)}), 400
 
+@app.route('/api/batch', methods=['POST'])
+def batch():
+    """Perform many calculations in one call: {"operations": [{"operation", "num1", "num2", "num3"}]}"""
+    if not algebra.initialized:
+        return jsonify({'success': False, 'error': 'Algebra not initialized'}), 400
+    current = algebra.snapshot()
+    
+    data = request.json
+    operations = []
+    for item in data.get('operations', []):
+        operation = item.get('operation', '')
+        if operation == 'modinv':  # Same name as in /api/calculate
+            operation = 'mod_inverse'
+        if operation not in BATCH_OPCODES:
+            return jsonify({'success': False, 'error': f'Unknown operation {operation}'}), 400
+        operations.append((operation, item.get('num1', ''), item.get('num2', ''), item.get('num3', '')))
+    
+    try:
+        results = current.evaluate_batch(operations, format=True)
+        return jsonify({
+            'success': True,
+            'results': [{'success': ok, 'result' if ok else 'error': text} for ok, text in results]
+        })
+    except Exception as e:
+        return jsonify({'success': False, 'error': str(e)}), 400
+
 @app.route('/api/table/<table_type>', methods=['GET'])
 def get_table(table_type):
     """Get operation table"""
-    global algebra
-    if not algebra or not algebra.initialized:
+    if not algebra.initialized:
         return jsonify({'success': False, 'error': 'Algebra not initialized'}), 400
+    current = algebra.snapshot()
+    
+    if table_type not in TABLE_KINDS:
+        return jsonify({'success': False, 'error': 'Unknown table type'}), 400
     
     try:
-        if table_type == 'addition':
-            table = algebra.get_addition_table()
-        elif table_type == 'multiplication':
-            table = algebra.get_multiplication_table()
-        elif table_type == 'subtraction':
-            table = algebra.get_subtraction_table()
-        elif table_type == 'division':
-            table = algebra.get_division_table()
-        elif table_type == 'addition_carry':
-            table = algebra.get_addition_carry_table()
-        elif table_type == 'multiplication_carry':
-            table = algebra.get_multiplication_carry_table()
-        else:
-            return jsonify({'success': False, 'error': 'Unknown table type'}), 400
-        
-        # Convert to serializable format
-        table_data = []
-        for (a, b), result in table.items():
-            table_data.append({
-                'a': a,
-                'b': b,
-                'result': result
-            })
+        # Rendered by the same table export as the console and Qt front ends
+        table = json.loads(current.render_table(table_type, 'json'))
         
         return jsonify({
             'success': True,
-            'elements': algebra.get_elements(),
-            'table': table_data
+            'elements': table['elements'],
+            'table': table
         })
     except Exception as e:
         return jsonify({'success': False, 'error': str(e)}), 400
@@ -130,20 +169,19 @@ def get_table(table_type):
 @app.route('/api/hasse', methods=['GET'])
 def get_hasse():
     """Get Hasse diagram data"""
-    global algebra
-    if not algebra or not algebra.initialized:
+    if not algebra.initialized:
         return jsonify({'success': False, 'error': 'Algebra not initialized'}), 400
+    current = algebra.snapshot()
     
     return jsonify({
         'success': True,
-        'positions': algebra.get_hasse_diagram_data()
+        'positions': current.get_hasse_diagram_data()
     })
 
 @app.route('/api/bounded', methods=['POST'])
 def set_bounded():
     """Enable/disable bounded mode"""
-    global algebra
-    if not algebra:
+    if not algebra.initialized:
         return jsonify({'success': False, 'error': 'Algebra not initialized'}), 400
     
     data = request.json
@@ -155,8 +193,9 @@ def set_bounded():
     # If enabling bounded mode and algebra is initialized, return max/min values
     if enabled and algebra.initialized:
         try:
-            max_val = algebra.format_result(algebra.get_max_value())
-            min_val = algebra.format_result(algebra.get_min_value())
+            current = algebra.snapshot()
+            max_val = current.format_result(current.get_max_value())
+            min_val = current.format_result(current.get_min_value())
             response['max_value'] = max_val
             response['min_value'] = min_val
         except:
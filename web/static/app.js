@@ -55,17 +55,23 @@ async function initAlgebra() {
 async function calculate(operation) {
     const num1 = document.getElementById('num1').value;
     const num2 = document.getElementById('num2').value;
+    const num3 = document.getElementById('num3').value;
     
     if (!num1 || !num2) {
         showError('Please enter both numbers');
         return;
     }
     
+    if (operation === 'powmod' && !num3) {
+        showError('Please enter the modulus');
+        return;
+    }
+    
     try {
         const response = await fetch(`${API_URL}/api/calculate`, {
             method: 'POST',
             headers: {'Content-Type': 'application/json'},
-            body: JSON.stringify({ num1, num2, operation })
+            body: JSON.stringify({ num1, num2, num3, operation })
         });
         
         const data = await response.json();
@@ -82,9 +88,10 @@ async function calculate(operation) {
             const opSymbols = {
                 'add': '+', 'subtract': '-', 'multiply': '×', 
                 'divide': '÷', 'power': '^', 'mod': 'mod',
-                'gcd': 'NOD', 'lcm': 'NOC'
+                'gcd': 'NOD', 'lcm': 'NOC', 'powmod': '^'
             };
-            addToHistory(num1, num2, opSymbols[operation] || operation, resultText);
+            const modulus = operation === 'powmod' ? num3 : '';
+            addToHistory(num1, num2, opSymbols[operation] || operation, resultText, modulus);
         } else {
             showError(data.error);
         }
@@ -94,8 +101,8 @@ async function calculate(operation) {
 }
 
 // Add to history
-function addToHistory(num1, num2, operation, result) {
-    const entry = { num1, num2, operation, result };
+function addToHistory(num1, num2, operation, result, num3 = '') {
+    const entry = { num1, num2, num3, operation, result };
     calculationHistory.unshift(entry);
     
     if (calculationHistory.length > MAX_HISTORY) {
@@ -110,7 +117,7 @@ function updateHistoryDisplay() {
     const historyDiv = document.getElementById('history');
     historyDiv.innerHTML = calculationHistory.map((entry, index) => 
         `<div class="history-item" onclick="loadFromHistory(${index})">
-            ${entry.num1} ${entry.operation} ${entry.num2} = ${entry.result}
+            ${entry.num1} ${entry.operation} ${entry.num2}${entry.num3 ? ` mod ${entry.num3}` : ''} = ${entry.result}
         </div>`
     ).join('');
 }
@@ -120,6 +127,7 @@ function loadFromHistory(index) {
     const entry = calculationHistory[index];
     document.getElementById('num1').value = entry.num1;
     document.getElementById('num2').value = entry.num2;
+    document.getElementById('num3').value = entry.num3 || '';
     document.getElementById('result').value = entry.result;
 }
 
@@ -135,6 +143,7 @@ function clearAll() {
     document.getElementById('rule').value = '';
     document.getElementById('num1').value = '';
     document.getElementById('num2').value = '';
+    document.getElementById('num3').value = '';
     document.getElementById('result').value = '';
     document.getElementById('boundedMode').checked = false;
     clearHistory();
@@ -189,13 +198,11 @@ function displayTable(display, elements, tableData, tableType) {
     });
     html += '</tr>';
     
-    // Data rows
-    elements.forEach(a => {
+    // Data rows: tableData.labels[row][col] is the display label of each cell
+    elements.forEach((a, row) => {
         html += `<tr><th>${a}</th>`;
-        elements.forEach(b => {
-            const entry = tableData.find(item => item.a === a && item.b === b);
-            const result = entry ? entry.result : '';
-            html += `<td>${result}</td>`;
+        elements.forEach((b, col) => {
+            html += `<td>${tableData.labels[row][col]}</td>`;
         });
         html += '</tr>';
     });